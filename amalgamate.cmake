@@ -0,0 +1,26 @@
+# 合并源文件为单个翻译单元，由 CMakeLists.txt 中的 vinteger_amalgamation / vinteger_submission 目标调用
+#   cmake -DOUTPUT=<文件> -DHEADERS=<头文件列表> -DSOURCES=<源文件列表> [-DMAIN=<主文件>] -P amalgamate.cmake
+# 头文件按给出的顺序展开在最前面，随后是各源文件与主文件；项目内的 #include "..." 全部去掉，标准库头文件保持原样
+
+foreach(var OUTPUT HEADERS SOURCES)
+    if (NOT ${var})
+        message(FATAL_ERROR "amalgamate.cmake: ${var} is not set")
+    endif()
+endforeach()
+
+# 项目内的文件已全部按顺序展开，其中的 #include "..." 不再需要
+function(append_file path)
+    file(READ "${path}" content)
+    string(REGEX REPLACE "#include \"[^\"]*\"[^\n]*\n" "" content "${content}")
+    get_filename_component(name "${path}" NAME)
+    file(APPEND "${OUTPUT}.tmp" "// ****** ${name} ******\n${content}\n")
+endfunction()
+
+file(WRITE "${OUTPUT}.tmp" "// 由 amalgamate.cmake 生成，请勿直接修改\n")
+foreach(path IN LISTS HEADERS SOURCES MAIN)
+    append_file("${path}")
+endforeach()
+
+# 内容不变时不改动输出文件，避免依赖它的目标重新编译
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${OUTPUT}.tmp" "${OUTPUT}")
+file(REMOVE "${OUTPUT}.tmp")
@@ -1,37 +0,0 @@
-#include <iostream>
-#include <iostream>
-#include <ctime>
-
-int A1; // A1 
-int A2; // A2
-
-int A3; /*
-*
-*
-*
-*/
-
-int A4; /**/ int A5;
-
-#define A6
-#define A7 \
-    A8\
-\
-    A9\
-
-#include "test_h3.h"
-
-int main() {
-    const char* S = "text";
-    const char* RS = R"--(
-    
-)--"; int a10; /*
-    A11
-*/
-    const char* RS2 = R"(1234)",* RS3 = R"(5678)";
-
-    if (a10)
-        a10 = 0;
-    else
-        a10 = 1;
-}
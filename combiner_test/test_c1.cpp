@@ -1,5 +0,0 @@
-#include "test_h.h"
-
-void test1() {
-
-}
\ No newline at end of file
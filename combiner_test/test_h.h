@@ -1,7 +0,0 @@
-#ifndef TEST_H_H
-#define TEST_H_H
-
-void test1();
-void test2();
-
-#endif // TEST_H_H
\ No newline at end of file
@@ -1,8 +0,0 @@
-#ifndef TEST_H2_H
-#define TEST_H2_H
-
-void test3() {
-    
-}
-
-#endif // TEST_H_H
\ No newline at end of file
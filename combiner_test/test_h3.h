@@ -1,7 +0,0 @@
-#ifndef TEST_H3_H
-#define TEST_H3_H
-
-#include "test_h.h"
-#include "test_h2.h"
-
-#endif
\ No newline at end of file
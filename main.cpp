@@ -1,8 +1,8 @@
-#include "vinteger.h"
-
-int main()
-{
-    algae::vinteger a, b;
-    std::cin >> a;
-    std::cout << a;
-}
+#include "vinteger.h"
+
+int main()
+{
+    algae::vinteger a, b;
+    std::cin >> a;
+    std::cout << a;
+}
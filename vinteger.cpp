@@ -1,145 +1,199 @@
-#include "vinteger.h"
-#include <cstring>
-
-namespace algae
-{
-    void vinteger::__change_capacity(std::uint32_t new_capacity, bool keep_value, bool initial)
-    {
-        if(new_capacity == 0)
-            return clear();
-
-        __CUtype * new_buffer = new __CUtype[new_capacity];
-        if(initial)
-            std::memset(new_buffer, 0, new_capacity * sizeof(__CUtype));
-
-        if(__buffer)
-        {
-            if(keep_value)
-                std::memcpy(new_buffer, __buffer, __capacity * sizeof(__CUtype));
-            delete[] __buffer;
-        }
-
-        __buffer = new_buffer;
-        __capacity = new_capacity;
-    }
-
-    void vinteger::__try_reserve(std::size_t unit_count)
-    {
-        if(unit_count > __capacity)
-            __change_capacity(unit_count, true);
-        else if(__value_length() == 0)
-            clear();
-    }
-
-    void vinteger::__capacity_adaptive() 
-    {
-        if(__capacity > __value_length())
-            __change_capacity(__value_length());
-    }
-
-
-    
-    void vinteger::__initialization_by_cinteger(std::int64_t x)
-    {
-        if(x == 0)
-            return;
-
-        __change_capacity(1);
-        __buffer[0] = (std::uintmax_t)std::abs(x);
-        __bit_length = std::bit_width(__buffer[0]) * (x < 0 ? -1 : 1);
-    }
-
-    void vinteger::__initialization_by_cinteger(std::uint64_t x)
-    {
-        __change_capacity(1);
-        __buffer[0] = x;
-        __bit_length = std::bit_width(__buffer[0]);
-    }
-   
-
-
-    vinteger::vinteger(const vinteger& source) { 
-        operator =(source);
-    }
-
-    vinteger::vinteger(vinteger&& source) {
-        operator =(std::move(source));
-    }
-
-
-
-    vinteger& vinteger::operator=(const vinteger& source)
-    {
-        if(this == &source)
-            return *this;
-
-        __change_capacity(source.__value_length());
-        std::memcpy(__buffer, source.__buffer, source.__value_length() * sizeof(__CUtype));
-        __bit_length = source.__bit_length;
-
-        return *this;
-    }
-
-    vinteger& vinteger::operator=(vinteger&& source)
-    {
-        if(this == &source)
-            return *this;
-
-        if(__buffer)
-            delete[] __buffer;
-
-        __buffer = std::exchange(source.__buffer, nullptr);
-        __bit_length = std::exchange(source.__bit_length, 0);
-        __capacity = std::exchange(source.__capacity, 0);
-        
-        return *this;
-    }
-
-
-
-    vinteger::~vinteger() {
-        clear();
-    }
-
-
-
-    bool vinteger::empty() const {
-        return __bit_length == 0;
-    }
-
-    int vinteger::sign() const 
-    {
-        if(__bit_length == 0)
-            return 0;
-
-        return __bit_length > 0 ? 1 : -1;
-    }
-
-    std::size_t vinteger::value_bit_width() const {
-        return std::abs(__bit_length);
-    }
-
-    inline std::size_t bit_capacity(const std::size_t bit_count, const std::size_t unit_size) {
-        return bit_count / unit_size + bool(bit_count % unit_size);
-    }
-
-    std::size_t vinteger::__value_length() const {
-        return bit_capacity(std::abs(__bit_length), __CUtype_bit_length);
-    }
-
-    std::size_t vinteger::__HCU_value_length() const {
-        return bit_capacity(std::abs(__bit_length), __HCUtype_bit_length);
-    }
-
-
-
-    void vinteger::clear()
-    {
-        if(__buffer)
-            delete[] __buffer;
-
-        __buffer = nullptr;
-        __bit_length = 0;
-        __capacity = 0;
-    }
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace algae
+{
+    // 缓冲区之前的一个计算单元保存引用计数
+    template<class T>
+    static std::atomic_ref<T> __reference_count(T* buffer) {
+        return std::atomic_ref<T>(buffer[-1]);
+    }
+
+    vinteger::__CUtype* vinteger::__allocate(std::size_t capacity)
+    {
+        ALGAE_VINTEGER_INSTRUMENT_ALLOCATION(capacity);
+
+        __CUtype* buffer = new __CUtype[capacity + 1] + 1;
+        buffer[-1] = 1;
+        return buffer;
+    }
+
+    // 容量为 0 的非空缓冲区是借用的外部内存（见 vinteger_view），不计数也不释放
+    void vinteger::__release()
+    {
+        if(__buffer && __capacity && __reference_count(__buffer).fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ALGAE_VINTEGER_INSTRUMENT_RELEASE();
+            delete[] (__buffer - 1);
+        }
+    }
+
+    bool vinteger::__shared() const {
+        return __buffer && __capacity && __reference_count(__buffer).load(std::memory_order_acquire) != 1;
+    }
+
+    void vinteger::__change_capacity(std::size_t new_capacity, bool keep_value, bool initial)
+    {
+        if(new_capacity == 0)
+            return clear();
+
+        __CUtype * new_buffer = __allocate(new_capacity);
+        if(initial)
+            std::memset(new_buffer, 0, new_capacity * sizeof(__CUtype));
+
+        if(__buffer)
+        {
+            if(keep_value)
+                std::memcpy(new_buffer, __buffer, std::min<std::size_t>(__capacity, new_capacity) * sizeof(__CUtype));
+            __release();
+        }
+
+        __buffer = new_buffer;
+        __capacity = new_capacity;
+    }
+
+    // 除了扩容之外，缓冲区与其他对象共享时也先复制一份，之后才能原地写入
+    void vinteger::__try_reserve(std::size_t unit_count)
+    {
+        if(unit_count > __capacity || __shared())
+            __change_capacity(std::max<std::size_t>(unit_count, __capacity), true);
+        else if(__value_length() == 0)
+            clear();
+    }
+
+    void vinteger::unshare()
+    {
+        if(__shared())
+            __change_capacity(__capacity, true);
+    }
+
+    void vinteger::__capacity_adaptive() 
+    {
+        if(__capacity > __value_length())
+            __change_capacity(__value_length());
+    }
+
+    void vinteger::__refresh_bit_length(std::size_t unit_count, int sign)
+    {
+        while(unit_count > 0 && __buffer[unit_count - 1] == 0)
+            --unit_count;
+
+        if(unit_count == 0)
+        {
+            __bit_length = 0;
+            return;
+        }
+
+        const std::int64_t bit_length = std::bit_width(__buffer[unit_count - 1]) + (unit_count - 1) * __CUtype_bit_length;
+        __bit_length = sign < 0 ? -bit_length : bit_length;
+    }
+
+
+    
+    void vinteger::__initialization_by_cinteger(std::int64_t x)
+    {
+        if(x == 0)
+            return;
+
+        __change_capacity(1);
+        __buffer[0] = (std::uintmax_t)std::abs(x);
+        __bit_length = std::bit_width(__buffer[0]) * (x < 0 ? -1 : 1);
+    }
+
+    void vinteger::__initialization_by_cinteger(std::uint64_t x)
+    {
+        __change_capacity(1);
+        __buffer[0] = x;
+        __bit_length = std::bit_width(__buffer[0]);
+    }
+   
+
+
+    vinteger::vinteger(const vinteger& source) { 
+        operator =(source);
+    }
+
+    vinteger::vinteger(vinteger&& source) {
+        operator =(std::move(source));
+    }
+
+
+
+    vinteger& vinteger::operator=(const vinteger& source)
+    {
+        if(this == &source)
+            return *this;
+
+        // 自有缓冲区只增加引用计数，首次修改时才复制；借用的缓冲区须立即复制
+        if(source.__buffer && source.__capacity)
+        {
+            __reference_count(source.__buffer).fetch_add(1, std::memory_order_relaxed);
+            __release();
+            __buffer = source.__buffer;
+            __capacity = source.__capacity;
+        }
+        else
+        {
+            __change_capacity(source.__value_length());
+            if(source.__value_length())
+                std::memcpy(__buffer, source.__buffer, source.__value_length() * sizeof(__CUtype));
+        }
+
+        __bit_length = source.__bit_length;
+
+        return *this;
+    }
+
+    vinteger& vinteger::operator=(vinteger&& source)
+    {
+        if(this == &source)
+            return *this;
+
+        __release();
+
+        __buffer = std::exchange(source.__buffer, nullptr);
+        __bit_length = std::exchange(source.__bit_length, 0);
+        __capacity = std::exchange(source.__capacity, 0);
+        
+        return *this;
+    }
+
+
+
+    bool vinteger::empty() const {
+        return __bit_length == 0;
+    }
+
+    int vinteger::sign() const 
+    {
+        if(__bit_length == 0)
+            return 0;
+
+        return __bit_length > 0 ? 1 : -1;
+    }
+
+    std::size_t vinteger::value_bit_width() const {
+        return std::abs(__bit_length);
+    }
+
+    std::size_t vinteger::__value_length() const {
+        return bit_capacity(std::abs(__bit_length), __CUtype_bit_length);
+    }
+
+    std::size_t vinteger::__HCU_value_length() const {
+        return bit_capacity(std::abs(__bit_length), __HCUtype_bit_length);
+    }
+
+
+
+    void vinteger::clear()
+    {
+        __release();
+
+        __buffer = nullptr;
+        __bit_length = 0;
+        __capacity = 0;
+    }
 }
\ No newline at end of file
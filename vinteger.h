@@ -1,339 +1,1210 @@
-#ifndef ALGAE_VINTEGER_H
-#define ALGAE_VINTEGER_H
-
-#include <compare>
-#include <cstdint>
-#include <string>
-#include <string_view>
-#include <utility>
-#include <cmath>
-#include <iostream>
-
-namespace algae
-{
-    class vinteger
-    {
-        // 转换中间态类，用于在高精度整数转换过程中作为中间状态
-        friend class intermediate_state_integer;
-
-        using __computing_unit_type = std::uint_fast64_t;
-        using __CUtype = __computing_unit_type;
-        using __HCUtype = std::uint_fast32_t;
-        constexpr static std::size_t __CUtype_bit_length = sizeof(std::uint64_t) * 8;
-        constexpr static std::size_t __HCUtype_bit_length = sizeof(std::uint32_t ) * 8;
-
-        __CUtype * __buffer = nullptr;
-        std::int32_t __bit_length = 0;
-        std::uint32_t __capacity = 0;
-
-        void __change_capacity(std::uint32_t new_capacity, bool keep_value = false, bool initial = false);
-        void __try_reserve(std::size_t unit_count);
-        void __capacity_adaptive();
-
-        void __initialization_by_cinteger(std::int64_t x);
-        void __initialization_by_cinteger(std::uint64_t x);
-
-    public:
-        using CUtype = __CUtype;
-
-        vinteger() = default;
-        
-        template<std::integral T>
-        vinteger(T x) 
-        { 
-            if(std::is_signed_v<T>)
-                __initialization_by_cinteger((std::int64_t)x); 
-            else
-                __initialization_by_cinteger((std::uint64_t)x); 
-        }
-
-        template<std::floating_point T>
-        vinteger(T x) { 
-            __initialization_by_cinteger((std::int64_t)std::floor(x)); 
-        }
-
-
-        vinteger(std::string_view source);
-        vinteger(const vinteger& source);
-        vinteger(vinteger&& source);
-
-
-        template<std::unsigned_integral T>
-        vinteger& operator=(const T x)
-        {
-            if(x == 0)
-                clear();
-            else
-                __change_capacity(1), __bit_length = std::bit_width(x);
-
-            return *this;
-        }
-
-        template<std::signed_integral T>
-        vinteger& operator=(const T x)
-        {
-            this->operator=((std::make_unsigned<T>)std::abs(x));
-            __bit_length = __set_int_sign(__bit_length, x < 0 ? -1 : 1);
-            return *this;
-        }
-
-        vinteger& operator=(const vinteger& source);
-        vinteger& operator=(vinteger&& source);
-
-        ~vinteger();
-
-
-
-        int sign() const; 
-        bool empty() const;
-        std::size_t value_bit_width() const;
-
-    private:
-        std::size_t __value_length() const;
-        std::size_t __HCU_value_length() const;
-    
-    public:
-        void clear();
-
-
-        // ****** cmp operations ******
-        friend std::strong_ordering operator <=>(const vinteger&, const vinteger&);
-
-    private:
-        std::strong_ordering __compare_template(const vinteger& a, const std::int64_t b);
-        std::strong_ordering __compare_template(const vinteger& a, const std::uint64_t b);
-    
-    public:
-        template<std::integral T>
-        friend std::strong_ordering operator <=>(const vinteger&, const T);
-
-        template<std::integral T>
-        friend std::strong_ordering operator <=>(const T, const vinteger&);
-
-        template<std::floating_point T>
-        friend std::strong_ordering operator <=>(const vinteger&, const T);
-
-        template<std::floating_point T>
-        friend std::strong_ordering operator <=>(const T, const vinteger&);
-
-
-
-        // ****** bit move ******
-        vinteger& operator <<=(const std::size_t shift);
-        vinteger operator<<(const std::size_t shift) const;
-        
-        vinteger& operator >>=(const std::size_t shift);
-        vinteger operator>>(const std::size_t shift) const;
-
-
-        // ****** arithmetic operations ******
-    private:
-        // adder_context 类，用于处理高精度整数加法和减法运算的上下文信息
-        friend struct adder_context;
-
-    public:
-        vinteger operator-() const;
-
-        friend vinteger operator+(const vinteger&, const vinteger&);
-        friend vinteger operator-(const vinteger&, const vinteger&);
-
-        template<std::integral T>
-        friend vinteger operator+(const vinteger&, const T);
-
-        template<std::integral T>
-        friend vinteger operator-(const vinteger&, const T);
-
-        template<std::integral T>
-        friend vinteger operator+(const T, const vinteger&);
-
-        template<std::integral T>
-        friend vinteger operator-(const T, const vinteger&);
-
-        
-
-        vinteger& operator+=(const vinteger& b);
-        vinteger& operator-=(const vinteger& b);
-
-        template<std::integral T>
-        vinteger& operator+=(const T x) {
-            return operator+=(vinteger(x));
-        }
-
-        template<std::integral T>
-        vinteger& operator-=(const T x) {
-            return operator-=(vinteger(x));
-        }
-
-        template<std::floating_point T>
-        vinteger& operator+=(const T x) {
-            return operator+=(vinteger(x));
-        }
-
-        template<std::floating_point T>
-        vinteger& operator-=(const T x) {
-            return operator-=(vinteger(x));
-        }
-
-
-    private:
-        friend struct multiplier_context;
-
-    public:
-        friend vinteger operator*(const vinteger&, const vinteger&);
-
-        template<std::integral T>
-        friend vinteger operator*(const vinteger&, const T);
-
-        template<std::integral T>
-        friend vinteger operator*(const T, const vinteger&);
-
-        vinteger& operator*=(const vinteger& other);
-
-        template<std::integral T>
-        vinteger operator*=(const T x) {
-            return (*this *= vinteger(x));
-        }
-
-    
-    
-    private:
-        friend struct divider_context;
-
-    public:
-        friend vinteger operator/(const vinteger&, const vinteger&);
-        friend vinteger operator%(const vinteger&, const vinteger&);
-
-        template<std::integral T>
-        friend vinteger operator/(const vinteger&, const T);
-
-        template<std::integral T>
-        friend vinteger operator/(const T, const vinteger&);
-
-        template<std::integral T>
-        friend vinteger operator%(const vinteger&, const T);
-
-        template<std::integral T>
-        friend vinteger operator%(const T, const vinteger&);
-
-        vinteger& operator/=(const vinteger& other);
-        vinteger& operator%=(const vinteger& other);
-
-        template<std::integral T>
-        vinteger operator/=(const T x) {
-            return (*this /= vinteger(x));
-        }
-
-        template<std::integral T>
-        vinteger operator%=(const T x) {
-            return (*this %= vinteger(x));
-        }
-
-        
-        std::string to_string() const;
-        operator std::string() const;
-    };
-
-    
-
-    std::strong_ordering operator <=>(const vinteger& a, const vinteger& b);
-
-    template<std::integral T>
-    std::strong_ordering operator <=>(const vinteger& a, const T b) {
-        return vinteger::__compare_template(a, b);
-    }
-
-    template<std::integral T>
-    std::strong_ordering operator <=>(const T b, const vinteger& a) 
-    {
-        auto r = vinteger::__compare_template(a, b);
-        
-        if(r == std::strong_ordering::less)
-            return std::strong_ordering::greater;
-
-        if(r == std::strong_ordering::greater)
-            return std::strong_ordering::less;
-
-        return std::strong_ordering::equal;
-    }
-
-    template<std::floating_point T>
-    std::strong_ordering operator <=>(const vinteger& a, const T b) {
-        return a <=> (std::int64_t)std::ceil(b);
-    }
-
-    template<std::floating_point T>
-    std::strong_ordering operator <=>(const T a, const vinteger& b) {
-        return (std::int64_t)std::ceil(a) <=> b;
-    }
-
-
-
-
-    vinteger operator+(const vinteger& a, const vinteger& b);
-    vinteger operator-(const vinteger& a, const vinteger& b);
-
-    template<std::integral T>
-    vinteger operator+(const vinteger& a, const T b) {
-        return a + vinteger(b);
-    }
-
-    template<std::integral T>
-    vinteger operator-(const vinteger& a, const T b) {
-        return a - vinteger(b);
-    }
-
-    template<std::integral T>
-    vinteger operator+(const T a, const vinteger& b) {
-        return vinteger(a) + b;
-    }
-
-    template<std::integral T>
-    vinteger operator-(const T a, const vinteger& b) {
-        return vinteger(a) - b;
-    }
-
-
-
-    vinteger operator*(const vinteger& a, const vinteger& b);
-
-    template<std::integral T>
-    vinteger operator*(const vinteger& a, const T b) {
-        return a * vinteger(b);
-    }
-
-    template<std::integral T>
-    vinteger operator*(const T a, const vinteger& b) {
-        return vinteger(a) * b;
-    }
-
-
-    template<std::integral T>
-    vinteger operator/(const vinteger& a, const T b) {
-        return a / vinteger(b);
-    }
-
-    template<std::integral T>
-    vinteger operator/(const T a, const vinteger& b) {
-        return vinteger(a) / b;
-    }
-
-    template<std::integral T>
-    vinteger operator%(const vinteger& a, const T b) {
-        return a % vinteger(b);
-    }
-
-    template<std::integral T>
-    vinteger operator%(const T a, const vinteger& b) {
-        return vinteger(a) % b;
-    }
-
-    
-    std::istream& operator >> (std::istream& in, vinteger& arg);
-    std::ostream& operator << (std::ostream& out, const vinteger& arg);
-    
-    namespace vinteger_literals {
-        vinteger operator ""_vi(const char* x);
-    }
-}
-
+#ifndef ALGAE_VINTEGER_H
+#define ALGAE_VINTEGER_H
+
+#include <array>
+#include <bit>
+#include <charconv>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <ranges>
+#include <vector>
+#include <cmath>
+#include <iostream>
+
+namespace algae
+{
+    // 并行执行策略，用于 mul 等可选的多线程运算
+    struct exec_policy
+    {
+        // 最多同时参与计算的线程数（包括调用线程），0 表示使用硬件并发数
+        std::size_t threads = 0;
+        // 子问题的最小规模（计算单元数），更小的子问题不再拆分为并行任务
+        std::size_t grain = 512;
+    };
+
+    class vinteger
+    {
+        // 十进制转换上下文，分治地在二进制与十进制之间转换
+        friend struct radix_context;
+        // 十进制格式化，批量输出时直接写入输出缓冲区
+        friend std::size_t __write_decimal(const vinteger& x, char* out, const exec_policy& policy);
+        // 模运算上下文类，需要直接读写计算单元以实现 Montgomery 约简
+        friend class mod_context;
+        // 延迟进位的累加器，直接读取操作数的计算单元
+        friend class vinteger_accumulator;
+        // 只读视图，其内部的 vinteger 借用外部缓冲区而不拥有它
+        friend class vinteger_view;
+
+        using __computing_unit_type = std::uint_fast64_t;
+        using __CUtype = __computing_unit_type;
+        using __HCUtype = std::uint_fast32_t;
+        constexpr static std::size_t __CUtype_bit_length = sizeof(std::uint64_t) * 8;
+        constexpr static std::size_t __HCUtype_bit_length = sizeof(std::uint32_t ) * 8;
+
+        __CUtype * __buffer = nullptr;
+        // 带符号的位宽与容量均为 64 位，数值大小不受 2^31 位的限制
+        std::int64_t __bit_length = 0;
+        std::uint64_t __capacity = 0;
+
+        // 缓冲区按引用计数共享（写时复制）：复制与取负只共享缓冲区，原地修改之前才复制
+        // 所有原地写入缓冲区的路径都须先经过 __change_capacity 或 __try_reserve，二者保证缓冲区不被共享
+        static __CUtype* __allocate(std::size_t capacity);
+        void __release();
+        bool __shared() const;
+
+        void __change_capacity(std::size_t new_capacity, bool keep_value = false, bool initial = false);
+        void __try_reserve(std::size_t unit_count);
+        void __capacity_adaptive();
+        // 根据前 unit_count 个计算单元重新计算位宽，并设置符号
+        void __refresh_bit_length(std::size_t unit_count, int sign = 1);
+
+        void __initialization_by_cinteger(std::int64_t x);
+        void __initialization_by_cinteger(std::uint64_t x);
+
+        // 计算单元乘法，返回 a * b 的低 64 位，高 64 位写入 high
+        static __CUtype __multiply_unit(const __CUtype a, const __CUtype b, __CUtype& high)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = (unsigned __int128)a * b;
+            high = __CUtype(product >> __CUtype_bit_length);
+            return __CUtype(product);
+#else
+            // 没有 128 位整数时，拆分为半计算单元做四次乘法
+            constexpr __CUtype mask = (__CUtype(1) << __HCUtype_bit_length) - 1;
+            const __CUtype al = a & mask, ah = a >> __HCUtype_bit_length;
+            const __CUtype bl = b & mask, bh = b >> __HCUtype_bit_length;
+
+            const __CUtype ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+            const __CUtype middle = (ll >> __HCUtype_bit_length) + (lh & mask) + (hl & mask);
+
+            high = hh + (lh >> __HCUtype_bit_length) + (hl >> __HCUtype_bit_length) + (middle >> __HCUtype_bit_length);
+            return (middle << __HCUtype_bit_length) | (ll & mask);
+#endif
+        }
+
+        // 计算单元除法，返回 (high * 2^64 + low) / divisor，余数写入 remainder
+        // divisor 的最高位须为 1，且 high < divisor，此时商不超过一个计算单元
+        static __CUtype __divide_unit(const __CUtype high, const __CUtype low, const __CUtype divisor, __CUtype& remainder)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 dividend = (unsigned __int128)high << __CUtype_bit_length | low;
+            remainder = __CUtype(dividend % divisor);
+            return __CUtype(dividend / divisor);
+#else
+            // 没有 128 位整数时，以半计算单元为数位做两步试商（Knuth 4.3.1 算法 D 的特例）
+            constexpr __CUtype base = __CUtype(1) << __HCUtype_bit_length, mask = base - 1;
+            const __CUtype dh = divisor >> __HCUtype_bit_length, dl = divisor & mask;
+            const __CUtype lh = low >> __HCUtype_bit_length, ll = low & mask;
+
+            __CUtype q1 = high / dh, r = high - q1 * dh;
+            while(q1 >= base || q1 * dl > (r << __HCUtype_bit_length | lh))
+            {
+                --q1, r += dh;
+                if(r >= base)
+                    break;
+            }
+
+            const __CUtype middle = (high << __HCUtype_bit_length) + lh - q1 * divisor;
+
+            __CUtype q0 = middle / dh;
+            r = middle - q0 * dh;
+            while(q0 >= base || q0 * dl > (r << __HCUtype_bit_length | ll))
+            {
+                --q0, r += dh;
+                if(r >= base)
+                    break;
+            }
+
+            remainder = (middle << __HCUtype_bit_length) + ll - q0 * divisor;
+            return q1 << __HCUtype_bit_length | q0;
+#endif
+        }
+
+    public:
+        using CUtype = __CUtype;
+
+        vinteger() = default;
+        
+        template<std::integral T>
+        vinteger(T x) 
+        { 
+            if(std::is_signed_v<T>)
+                __initialization_by_cinteger((std::int64_t)x); 
+            else
+                __initialization_by_cinteger((std::uint64_t)x); 
+        }
+
+        template<std::floating_point T>
+        vinteger(T x) { 
+            __initialization_by_cinteger((std::int64_t)std::floor(x)); 
+        }
+
+
+        vinteger(std::string_view source);
+        // 按执行策略并行解析十进制字符串
+        vinteger(std::string_view source, const exec_policy& policy);
+        vinteger(const vinteger& source);
+        vinteger(vinteger&& source);
+
+
+        template<std::unsigned_integral T>
+        vinteger& operator=(const T x)
+        {
+            if(x == 0)
+                clear();
+            else
+                __change_capacity(1), __buffer[0] = x, __bit_length = std::bit_width(x);
+
+            return *this;
+        }
+
+        template<std::signed_integral T>
+        vinteger& operator=(const T x)
+        {
+            this->operator=((std::make_unsigned_t<T>)(x < 0 ? -(std::make_unsigned_t<T>)x : x));
+            if(x < 0)
+                __bit_length = -__bit_length;
+            return *this;
+        }
+
+        vinteger& operator=(const vinteger& source);
+        vinteger& operator=(vinteger&& source);
+
+        // 空值与借用的缓冲区（容量为 0）析构时什么也不做，因此借用静态存储的视图可以在常量求值中构造与析构
+        constexpr ~vinteger()
+        {
+            if(__capacity)
+                clear();
+        }
+
+
+
+        int sign() const; 
+        bool empty() const;
+        std::size_t value_bit_width() const;
+
+    private:
+        std::size_t __value_length() const;
+        std::size_t __HCU_value_length() const;
+    
+    public:
+        void clear();
+        // 确保缓冲区不与其他对象共享；在反复修改同一个对象的热循环之前调用，可以把复制提前到循环之外
+        void unshare();
+
+
+        // ****** cmp operations ******
+        friend std::strong_ordering operator <=>(const vinteger&, const vinteger&);
+
+    private:
+        static std::strong_ordering __compare_template(const vinteger& a, const std::int64_t b);
+        static std::strong_ordering __compare_template(const vinteger& a, const std::uint64_t b);
+    
+    public:
+        template<std::integral T>
+        friend std::strong_ordering operator <=>(const vinteger&, const T);
+
+        template<std::integral T>
+        friend std::strong_ordering operator <=>(const T, const vinteger&);
+
+        template<std::floating_point T>
+        friend std::strong_ordering operator <=>(const vinteger&, const T);
+
+        template<std::floating_point T>
+        friend std::strong_ordering operator <=>(const T, const vinteger&);
+
+
+
+        // ****** bit move ******
+        vinteger& operator <<=(const std::size_t shift);
+        vinteger operator<<(const std::size_t shift) const;
+        
+        vinteger& operator >>=(const std::size_t shift);
+        vinteger operator>>(const std::size_t shift) const;
+
+
+        // ****** arithmetic operations ******
+    private:
+        // adder_context 类，用于处理高精度整数加法和减法运算的上下文信息
+        friend struct adder_context;
+
+    public:
+        vinteger operator-() const;
+
+        friend vinteger operator+(const vinteger&, const vinteger&);
+        friend vinteger operator-(const vinteger&, const vinteger&);
+
+        template<std::integral T>
+        friend vinteger operator+(const vinteger&, const T);
+
+        template<std::integral T>
+        friend vinteger operator-(const vinteger&, const T);
+
+        template<std::integral T>
+        friend vinteger operator+(const T, const vinteger&);
+
+        template<std::integral T>
+        friend vinteger operator-(const T, const vinteger&);
+
+        
+
+        vinteger& operator+=(const vinteger& b);
+        vinteger& operator-=(const vinteger& b);
+
+        template<std::integral T>
+        vinteger& operator+=(const T x) {
+            return operator+=(vinteger(x));
+        }
+
+        template<std::integral T>
+        vinteger& operator-=(const T x) {
+            return operator-=(vinteger(x));
+        }
+
+        template<std::floating_point T>
+        vinteger& operator+=(const T x) {
+            return operator+=(vinteger(x));
+        }
+
+        template<std::floating_point T>
+        vinteger& operator-=(const T x) {
+            return operator-=(vinteger(x));
+        }
+
+
+    private:
+        friend struct multiplier_context;
+
+    public:
+        friend vinteger operator*(const vinteger&, const vinteger&);
+
+        template<std::integral T>
+        friend vinteger operator*(const vinteger&, const T);
+
+        template<std::integral T>
+        friend vinteger operator*(const T, const vinteger&);
+
+        vinteger& operator*=(const vinteger& other);
+
+        template<std::integral T>
+        vinteger operator*=(const T x) {
+            return (*this *= vinteger(x));
+        }
+
+    
+    
+    private:
+        friend struct divider_context;
+
+    public:
+        friend vinteger operator/(const vinteger&, const vinteger&);
+        friend vinteger operator%(const vinteger&, const vinteger&);
+
+        template<std::integral T>
+        friend vinteger operator/(const vinteger&, const T);
+
+        template<std::integral T>
+        friend vinteger operator/(const T, const vinteger&);
+
+        template<std::integral T>
+        friend vinteger operator%(const vinteger&, const T);
+
+        template<std::integral T>
+        friend vinteger operator%(const T, const vinteger&);
+
+        vinteger& operator/=(const vinteger& other);
+        vinteger& operator%=(const vinteger& other);
+
+        template<std::integral T>
+        vinteger operator/=(const T x) {
+            return (*this /= vinteger(x));
+        }
+
+        template<std::integral T>
+        vinteger operator%=(const T x) {
+            return (*this %= vinteger(x));
+        }
+
+
+    private:
+        friend struct gcd_context;
+        friend struct root_context;
+        friend struct prime_context;
+        friend struct reduction_context;
+        friend struct serialization_context;
+        friend struct import_export_context;
+        friend struct mapped_context;
+
+    public:
+        // ****** primality ******
+        // Baillie-PSW 概率素数测试（以 2 为底的 Miller-Rabin 加强 Lucas 测试），负数按绝对值判断
+        // 与 GMP 相同，rounds 超过 24 的部分另做随机底数的 Miller-Rabin
+        bool is_probable_prime(int rounds = 25) const;
+        // 大于 *this 的最小（概率）素数
+        vinteger next_prime() const;
+
+        std::string to_string() const;
+        // 按执行策略并行转换为十进制字符串
+        std::string to_string(const exec_policy& policy) const;
+        operator std::string() const;
+    };
+
+    // 对象布局：缓冲区指针、带符号的 64 位位宽与 64 位容量，共 24 字节，没有填充
+    // 位宽须超过 32 位才能表示 2^32 位以上的数值，因此把符号并入容量也无法回到 16 字节（8 + 8 + 4 仍按 8 字节对齐为 24）
+    // 唯一能回到 16 字节的做法是把容量移入堆上的缓冲区头部，但那样 __try_reserve 每次都要多一次访存，容量为 0 也不再能标记借用的缓冲区
+    static_assert(sizeof(vinteger) == sizeof(void*) + 2 * sizeof(std::uint64_t), "vinteger layout is pointer + 64-bit bit length + 64-bit capacity");
+
+    
+
+    std::strong_ordering operator <=>(const vinteger& a, const vinteger& b);
+
+    template<std::integral T>
+    std::strong_ordering operator <=>(const vinteger& a, const T b) {
+        return vinteger::__compare_template(a, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>(b));
+    }
+
+    template<std::integral T>
+    std::strong_ordering operator <=>(const T b, const vinteger& a) 
+    {
+        auto r = vinteger::__compare_template(a, std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>(b));
+        
+        if(r == std::strong_ordering::less)
+            return std::strong_ordering::greater;
+
+        if(r == std::strong_ordering::greater)
+            return std::strong_ordering::less;
+
+        return std::strong_ordering::equal;
+    }
+
+    template<std::floating_point T>
+    std::strong_ordering operator <=>(const vinteger& a, const T b) {
+        return a <=> (std::int64_t)std::ceil(b);
+    }
+
+    template<std::floating_point T>
+    std::strong_ordering operator <=>(const T a, const vinteger& b) {
+        return (std::int64_t)std::ceil(a) <=> b;
+    }
+
+
+
+
+    vinteger operator+(const vinteger& a, const vinteger& b);
+    vinteger operator-(const vinteger& a, const vinteger& b);
+
+    template<std::integral T>
+    vinteger operator+(const vinteger& a, const T b) {
+        return a + vinteger(b);
+    }
+
+    template<std::integral T>
+    vinteger operator-(const vinteger& a, const T b) {
+        return a - vinteger(b);
+    }
+
+    template<std::integral T>
+    vinteger operator+(const T a, const vinteger& b) {
+        return vinteger(a) + b;
+    }
+
+    template<std::integral T>
+    vinteger operator-(const T a, const vinteger& b) {
+        return vinteger(a) - b;
+    }
+
+
+
+    vinteger operator*(const vinteger& a, const vinteger& b);
+
+    template<std::integral T>
+    vinteger operator*(const vinteger& a, const T b) {
+        return a * vinteger(b);
+    }
+
+    template<std::integral T>
+    vinteger operator*(const T a, const vinteger& b) {
+        return vinteger(a) * b;
+    }
+
+    // 按执行策略在线程池上并行计算 a * b，结果与 operator* 相同
+    vinteger mul(const vinteger& a, const vinteger& b, const exec_policy& policy);
+
+
+    vinteger operator/(const vinteger& a, const vinteger& b);
+    vinteger operator%(const vinteger& a, const vinteger& b);
+
+    template<std::integral T>
+    vinteger operator/(const vinteger& a, const T b) {
+        return a / vinteger(b);
+    }
+
+    template<std::integral T>
+    vinteger operator/(const T a, const vinteger& b) {
+        return vinteger(a) / b;
+    }
+
+    template<std::integral T>
+    vinteger operator%(const vinteger& a, const T b) {
+        return a % vinteger(b);
+    }
+
+    template<std::integral T>
+    vinteger operator%(const T a, const vinteger& b) {
+        return vinteger(a) % b;
+    }
+
+    // 同时求商与余数，只做一次除法；商向零取整、余数与被除数同号，与 operator/ 和 operator% 的结果相同
+    std::pair<vinteger, vinteger> divmod(const vinteger& a, const vinteger& b);
+    // 以下带余除法都只做一次除法，满足 a = q * b + r 且 |r| < |b|，返回商 q，余数写入 remainder
+    // remainder 可以与 a 或 b 是同一个对象
+    // 商向零取整，r 与 a 同号
+    vinteger tdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder);
+    // 商向负无穷取整，r 与 b 同号
+    vinteger fdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder);
+    // 商向正无穷取整，r 与 b 异号
+    vinteger cdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder);
+    // floor(a / 2^k)，以移位代替除法
+    vinteger div_2exp(const vinteger& a, std::size_t k);
+    // a mod 2^k，结果在 [0, 2^k) 中，a = div_2exp(a, k) * 2^k + mod_2exp(a, k)；非负数只截取低 k 位
+    vinteger mod_2exp(const vinteger& a, std::size_t k);
+    // 已知 b 整除 a 时求 a / b：以 b 在模 2^64 下的逆元自低位向高位求商（Hensel 除法），不需要试商与修正
+    // b 不整除 a 时结果无意义
+    vinteger divexact(const vinteger& a, const vinteger& b);
+
+    template<std::integral T>
+    vinteger divexact(const vinteger& a, const T b) {
+        return divexact(a, vinteger(b));
+    }
+
+    
+    // 固定模数的模运算上下文
+    // 构造时一次性预计算约简所需的常数：奇数模数使用 Montgomery 约简，偶数模数使用 Barrett 约简
+    // mul/sqr/add/sub/pow 的参数与结果都处于约简域中，取值范围为 [0, modulus)
+    // 通过 to_domain/from_domain 在普通 vinteger 与约简域之间转换
+    class mod_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        // 模数（恒为正）
+        vinteger __modulus;
+        // 模数的计算单元长度
+        std::size_t __length = 0;
+        // 是否使用 Montgomery 约简（模数为奇数时）
+        bool __montgomery = false;
+
+        // Montgomery: -modulus^-1 mod 2^64
+        __CUtype __inverse = 0;
+        // Montgomery: R^2 mod modulus，其中 R = 2^(64 * __length)
+        vinteger __r_square;
+        // 约简域中的 1
+        vinteger __one;
+
+        // Barrett: floor(4^k / modulus)，其中 k 为模数的二进制位宽
+        vinteger __reciprocal;
+
+        vinteger __montgomery_multiply(const vinteger& a, const vinteger& b) const;
+        vinteger __barrett_reduce(const vinteger& x) const;
+        vinteger __normalize(const vinteger& x) const;
+
+    public:
+        explicit mod_context(const vinteger& modulus);
+
+        const vinteger& modulus() const;
+        bool montgomery() const;
+
+        vinteger to_domain(const vinteger& x) const;
+        vinteger from_domain(const vinteger& x) const;
+        vinteger one() const;
+
+        vinteger mul(const vinteger& a, const vinteger& b) const;
+        vinteger sqr(const vinteger& a) const;
+        vinteger add(const vinteger& a, const vinteger& b) const;
+        vinteger sub(const vinteger& a, const vinteger& b) const;
+        vinteger pow(const vinteger& a, const vinteger& exponent) const;
+    };
+
+
+    // ****** combinatorics ******
+    // 以反复平方计算 base^exponent，0^0 定义为 1
+    vinteger pow(const vinteger& base, std::uint64_t exponent);
+    // 以素数摆动（prime swing）与平衡乘积树计算 n!
+    vinteger factorial(std::uint64_t n);
+    // 以素因子分解（Kummer 定理）与平衡乘积树计算组合数 C(n, k)，k > n 时为 0
+    vinteger binomial(std::uint64_t n, std::uint64_t k);
+    // 不超过 n 的所有素数之积
+    vinteger primorial(std::uint64_t n);
+
+
+    // ****** gcd ******
+    // 最大公约数，结果非负；gcd(0, 0) = 0
+    vinteger gcd(const vinteger& a, const vinteger& b);
+    // 最小公倍数，结果非负；任一操作数为 0 时结果为 0
+    vinteger lcm(const vinteger& a, const vinteger& b);
+    // 扩展欧几里得，返回 g = gcd(a, b)，并求出满足 a * s + b * t = g 的 s 与 t
+    vinteger gcdext(const vinteger& a, const vinteger& b, vinteger& s, vinteger& t);
+    // 模逆元，返回 [0, |m|) 中满足 a * x ≡ 1 (mod m) 的 x，不可逆时抛出异常
+    vinteger invert(const vinteger& a, const vinteger& m);
+
+
+    // ****** root ******
+    // 整数平方根 floor(sqrt(n))，n 为负时抛出异常
+    vinteger isqrt(const vinteger& n);
+    // 返回 s = isqrt(n)，并求出余数 n - s * s
+    vinteger sqrtrem(const vinteger& n, vinteger& remainder);
+    // 整数 k 次方根，向零取整；k 为偶数时 n 须非负
+    vinteger iroot(const vinteger& n, std::uint64_t k);
+    bool is_perfect_square(const vinteger& n);
+
+
+    // ****** primality ******
+    // Jacobi 符号 (a / n)，n 须为正奇数
+    int jacobi(const vinteger& a, const vinteger& n);
+
+
+    // ****** accumulator ******
+    // 延迟进位的累加器，适用于先累加大量项、最后才读取结果的场景（内积、多项式求值等）
+    // 正负两部分各自按计算单元分列保存：每列记录 64 位的低位和与溢出次数，相当于 128 位的列
+    // add/sub/addmul/submul 只做列内加法，不传播进位也不计算位宽，value() 时统一规范化一次
+    class vinteger_accumulator
+    {
+        using __CUtype = vinteger::__CUtype;
+
+        // 下标 0 为正数部分，1 为负数部分
+        std::vector<__CUtype> __low[2], __carry[2];
+
+        void __reserve(int side, std::size_t length);
+        void __add_units(int side, const __CUtype* units, std::size_t length);
+        void __add_product(int side, const vinteger& a, const vinteger& b);
+        vinteger __normalize(int side) const;
+
+    public:
+        vinteger_accumulator() = default;
+        explicit vinteger_accumulator(const vinteger& initial);
+
+        void add(const vinteger& x);
+        void sub(const vinteger& x);
+        // 累加 a * b
+        void addmul(const vinteger& a, const vinteger& b);
+        // 累减 a * b
+        void submul(const vinteger& a, const vinteger& b);
+        // 累加另一个累加器的内容
+        void merge(const vinteger_accumulator& other);
+        void clear();
+
+        // 传播进位并返回累加结果，累加器本身保持不变
+        vinteger value() const;
+        explicit operator vinteger() const;
+    };
+
+
+    // ****** reduction ******
+    // 批量归约的内核，操作数以指针数组传入，定义于 vinteger_reduction.cpp
+    vinteger __sum(const vinteger* const* items, std::size_t count, const exec_policy& policy);
+    vinteger __product(const vinteger* const* items, std::size_t count, const exec_policy& policy);
+    vinteger __dot(const vinteger* const* a, std::size_t a_count, const vinteger* const* b, std::size_t b_count, const exec_policy& policy);
+
+    // 收集范围内各元素的地址；元素不是 vinteger 左值时，先转换并保存到 storage 中
+    template<std::ranges::input_range R>
+    std::vector<const vinteger*> __reduction_operands(R&& range, std::vector<vinteger>& storage)
+    {
+        using reference = std::ranges::range_reference_t<R>;
+        std::vector<const vinteger*> operands;
+
+        if constexpr(std::is_lvalue_reference_v<reference> && std::same_as<std::remove_cvref_t<reference>, vinteger>)
+        {
+            for(const vinteger& x : range)
+                operands.push_back(&x);
+        }
+        else
+        {
+            for(auto&& x : range)
+                storage.emplace_back(std::forward<decltype(x)>(x));
+
+            for(const vinteger& x : storage)
+                operands.push_back(&x);
+        }
+
+        return operands;
+    }
+
+    template<class R>
+    concept __vinteger_range = std::ranges::input_range<R> && std::constructible_from<vinteger, std::ranges::range_reference_t<R>>;
+
+    // 范围内所有元素之和，按计算单元分列累加并推迟进位，最后只传播一次进位
+    template<__vinteger_range R>
+    vinteger sum(R&& range, const exec_policy& policy = {1})
+    {
+        std::vector<vinteger> storage;
+        const std::vector<const vinteger*> operands = __reduction_operands(std::forward<R>(range), storage);
+        return __sum(operands.data(), operands.size(), policy);
+    }
+
+    // 范围内所有元素之积，以平衡乘积树计算，空范围为 1
+    template<__vinteger_range R>
+    vinteger product(R&& range, const exec_policy& policy = {1})
+    {
+        std::vector<vinteger> storage;
+        const std::vector<const vinteger*> operands = __reduction_operands(std::forward<R>(range), storage);
+        return __product(operands.data(), operands.size(), policy);
+    }
+
+    // 两个等长范围的内积，长度不同时抛出异常
+    template<__vinteger_range A, __vinteger_range B>
+    vinteger dot(A&& a, B&& b, const exec_policy& policy = {1})
+    {
+        std::vector<vinteger> a_storage, b_storage;
+        const std::vector<const vinteger*> a_operands = __reduction_operands(std::forward<A>(a), a_storage);
+        const std::vector<const vinteger*> b_operands = __reduction_operands(std::forward<B>(b), b_storage);
+        return __dot(a_operands.data(), a_operands.size(), b_operands.data(), b_operands.size(), policy);
+    }
+
+
+    // ****** serialization ******
+    // 版本化的二进制记录：头部记录版本、符号与位宽，之后是小端序的计算单元
+    // 位宽不超过 64 的值可以使用紧凑形式（LEB128 变长编码）；完整形式的计算单元在记录按 8 字节对齐时也按 8 字节对齐
+    struct serialized_record
+    {
+        // 记录占用的字节数
+        std::size_t size = 0;
+        int sign = 0;
+        std::uint64_t bit_length = 0;
+        // 完整形式中计算单元的原始字节（小端序），紧凑形式下为空
+        std::span<const std::byte> limb_bytes;
+        // 本机为小端序且计算单元对齐时，直接指向缓冲区中的计算单元，否则为 nullptr
+        const std::uint64_t* limbs = nullptr;
+        // 紧凑形式的绝对值
+        std::uint64_t small = 0;
+    };
+
+    // 序列化后的字节数
+    std::size_t serialized_size(const vinteger& x, bool compact = true);
+    // 写入 out 并返回写入的字节数，空间不足时抛出异常
+    std::size_t serialize(const vinteger& x, std::span<std::byte> out, bool compact = true);
+    std::vector<std::byte> serialize(const vinteger& x, bool compact = true);
+    // 解析 in 开头的一条记录而不复制计算单元，记录无效时抛出异常
+    serialized_record peek_record(std::span<const std::byte> in);
+    // 反序列化 in 开头的一条记录，consumed 非空时写入记录占用的字节数
+    vinteger deserialize(std::span<const std::byte> in, std::size_t* consumed = nullptr);
+
+
+    // ****** import / export ******
+    // 字序：缓冲区中先存放最低有效字还是最高有效字
+    enum class word_order
+    {
+        least_significant_first,
+        most_significant_first
+    };
+
+    // 与 mpz_import 相同，把 count 个 word_size 字节的字解释为非负整数，字内字节序由 endian 指定
+    vinteger import_bits(const void* data, std::size_t count, std::size_t word_size, word_order order = word_order::least_significant_first, std::endian endian = std::endian::native);
+    // data 的长度须是 word_size 的整数倍
+    vinteger import_bits(std::span<const std::byte> data, std::size_t word_size, word_order order = word_order::least_significant_first, std::endian endian = std::endian::native);
+    // 导出 |x| 所需的字数，x 为 0 时为 0
+    std::size_t export_count(const vinteger& x, std::size_t word_size);
+    // 与 mpz_export 相同，按给定布局写出 |x| 并返回写入的字数，out 须能容纳 export_count(x, word_size) 个字
+    std::size_t export_bits(const vinteger& x, void* out, std::size_t word_size, word_order order = word_order::least_significant_first, std::endian endian = std::endian::native);
+    std::vector<std::byte> export_bits(const vinteger& x, std::size_t word_size, word_order order = word_order::least_significant_first, std::endian endian = std::endian::native);
+
+
+    // ****** view ******
+    // 借用外部计算单元缓冲区的只读整数，例如内存映射文件或网络缓冲区中的数据，构造时不复制计算单元
+    // 可以隐式转换为 const vinteger&，因此所有接受 const vinteger& 的运算、比较与转换函数都能直接以视图为操作数
+    // 缓冲区须在视图及其副本的生存期内保持有效且不被修改
+    class vinteger_view
+    {
+        // 借用缓冲区的 vinteger，其 __buffer 指向外部内存，析构前须解除借用
+        vinteger __value;
+        // 紧凑形式记录的绝对值，视图此时借用这一计算单元
+        std::uint64_t __small = 0;
+
+        void __borrow(const std::uint64_t* limbs, std::size_t count, int sign);
+
+        // 解除借用，之后 __value 的析构不会访问缓冲区
+        constexpr void __release()
+        {
+            __value.__buffer = nullptr;
+            __value.__bit_length = 0;
+            __value.__capacity = 0;
+        }
+
+    public:
+        vinteger_view() = default;
+        // 以小端序的计算单元与符号构造，高位的 0 会被忽略，sign 为负时表示负数
+        explicit vinteger_view(std::span<const std::uint64_t> limbs, int sign = 1);
+        // 借用 std::array 中的非负值，可以在常量求值中构造，用于 constexpr 与 constinit 变量
+        template<std::size_t N>
+        constexpr explicit vinteger_view(const std::array<std::uint64_t, N>& limbs)
+        {
+            static_assert(std::is_same_v<vinteger::__CUtype, std::uint64_t>, "borrowed limbs must have the computing unit type");
+
+            std::size_t length = N;
+            while(length > 0 && limbs[length - 1] == 0)
+                --length;
+
+            if(length)
+            {
+                __value.__buffer = const_cast<std::uint64_t*>(limbs.data());
+                __value.__bit_length = std::int64_t((length - 1) * vinteger::__CUtype_bit_length + std::bit_width(limbs[length - 1]));
+            }
+        }
+        // 借用另一个 vinteger 的缓冲区，source 须在视图的生存期内保持不变
+        vinteger_view(const vinteger& source);
+        // 借用 peek_record 得到的记录，完整形式的计算单元不能原地引用时抛出异常
+        explicit vinteger_view(const serialized_record& record);
+
+        vinteger_view(const vinteger_view& source);
+        vinteger_view& operator=(const vinteger_view& source);
+        constexpr ~vinteger_view() {
+            __release();
+        }
+
+        int sign() const;
+        bool empty() const;
+        std::size_t value_bit_width() const;
+        // 借用的计算单元（不含高位的 0）
+        std::span<const std::uint64_t> limbs() const;
+
+        const vinteger& value() const;
+        operator const vinteger&() const;
+
+        vinteger operator-() const;
+        vinteger operator<<(std::size_t shift) const;
+        vinteger operator>>(std::size_t shift) const;
+
+        std::string to_string() const;
+        std::string to_string(const exec_policy& policy) const;
+    };
+
+
+    // ****** mapped storage ******
+    // 文件映射存储与分块乘法的参数
+    struct storage_policy
+    {
+        // 临时文件所在目录，为空时使用系统临时目录
+        std::string scratch_directory;
+        // 分块乘法中驻留内存的工作集上限（字节），输入与输出都在映射文件中，由操作系统按需换入换出
+        std::size_t memory_budget = std::size_t(1) << 30;
+        // 块乘积使用的执行策略
+        exec_policy policy{1};
+    };
+
+    class mapped_vinteger;
+    // 分块计算 a * b，结果写入 storage 指定目录中的映射文件
+    // 两个操作数按内存预算切块，逐对相乘后累加到输出文件中，操作数本身可以是映射文件的视图
+    mapped_vinteger mapped_mul(const vinteger& a, const vinteger& b, const storage_policy& storage = {});
+
+    // 计算单元保存在内存映射文件中的只读整数，适用于超出内存容量的数值
+    // 文件内容与 serialize(x, false) 的输出相同，通过 view() 或隐式转换参与运算而不复制计算单元
+    // 新建的文件是临时文件，析构时删除，除非调用 persist() 保存
+    class mapped_vinteger
+    {
+        std::string __path;
+        void* __mapping = nullptr;
+        std::size_t __mapping_size = 0;
+        bool __temporary = false;
+        vinteger_view __view;
+
+        void __map(int fd, std::size_t size, bool writable);
+        void __create(const storage_policy& storage, std::size_t length);
+        void __finish(int sign, std::uint64_t bit_length);
+        void __close();
+        unsigned char* __data() const;
+
+        friend mapped_vinteger mapped_mul(const vinteger& a, const vinteger& b, const storage_policy& storage);
+
+    public:
+        mapped_vinteger() = default;
+        // 把 x 写入 storage 指定目录中的新临时文件
+        explicit mapped_vinteger(const vinteger& x, const storage_policy& storage = {});
+        // 以只读方式映射已有的记录文件
+        static mapped_vinteger open(const std::string& path);
+
+        mapped_vinteger(const mapped_vinteger&) = delete;
+        mapped_vinteger& operator=(const mapped_vinteger&) = delete;
+        mapped_vinteger(mapped_vinteger&& source);
+        mapped_vinteger& operator=(mapped_vinteger&& source);
+        ~mapped_vinteger();
+
+        // 将内容同步到磁盘，并把文件移动到 path 永久保存
+        void persist(const std::string& path);
+
+        const vinteger_view& view() const;
+        operator const vinteger&() const;
+        // 复制到内存中的 vinteger
+        vinteger load() const;
+        const std::string& path() const;
+    };
+
+
+    // ****** bulk I/O ******
+    // 批量读取以空白分隔的整数，适用于单个输入中有大量数值的批处理程序
+    // 来源是普通文件时整体映射到内存，否则（管道、终端）按大块缓冲读取；数值直接在缓冲区中解析，不经过 std::string
+    class vinteger_reader
+    {
+        int __fd = -1;
+        bool __owns_fd = false;
+        void* __mapping = nullptr;
+        std::size_t __mapping_size = 0;
+        std::vector<char> __buffer;
+        // 尚未读取的输入
+        const char* __begin = nullptr;
+        const char* __end = nullptr;
+        bool __failed = false;
+
+        void __open(int fd);
+        std::size_t __refill();
+
+    public:
+        // 默认读取标准输入
+        explicit vinteger_reader(int fd = 0);
+        explicit vinteger_reader(const std::string& path);
+        ~vinteger_reader();
+
+        vinteger_reader(const vinteger_reader&) = delete;
+        vinteger_reader& operator=(const vinteger_reader&) = delete;
+
+        // 下一个以空白分隔的词元，在下一次读取前有效；输入结束时返回空串
+        std::string_view token();
+
+        // 读取下一个整数，输入结束时返回 false 且不修改 x
+        bool read(vinteger& x);
+
+        template<std::integral T>
+        bool read(T& x)
+        {
+            std::string_view t = token();
+            if(t.empty())
+                return false;
+
+            if(t.size() > 1 && t[0] == '+')
+                t.remove_prefix(1);
+
+            const auto [end, error] = std::from_chars(t.data(), t.data() + t.size(), x);
+            if(error != std::errc() || end != t.data() + t.size())
+                throw std::invalid_argument("source is not a valid integer");
+
+            return true;
+        }
+
+        // 与 std::istream 相同的用法：输入结束后转换为 false
+        template<class T>
+        vinteger_reader& operator>>(T& x)
+        {
+            __failed = __failed || !read(x);
+            return *this;
+        }
+
+        explicit operator bool() const {
+            return !__failed;
+        }
+    };
+
+    // 批量输出，格式化结果直接写入输出缓冲区，缓冲区满时一次写出
+    class vinteger_writer
+    {
+        int __fd = -1;
+        bool __owns_fd = false;
+        std::vector<char> __buffer;
+        std::size_t __size = 0;
+
+        void __write_all(const char* data, std::size_t size);
+
+    public:
+        constexpr static std::size_t default_buffer_size = std::size_t(1) << 20;
+
+        // 默认写入标准输出
+        explicit vinteger_writer(int fd = 1, std::size_t buffer_size = default_buffer_size);
+        // 创建或截断 path
+        explicit vinteger_writer(const std::string& path, std::size_t buffer_size = default_buffer_size);
+        // 析构时写出缓冲区中剩余的内容
+        ~vinteger_writer();
+
+        vinteger_writer(const vinteger_writer&) = delete;
+        vinteger_writer& operator=(const vinteger_writer&) = delete;
+
+        void write(const vinteger& x);
+        void write(std::string_view s);
+        void write(char c);
+
+        template<std::integral T>
+        void write(const T x)
+        {
+            char digits[48];
+            const auto [end, error] = std::to_chars(digits, digits + sizeof(digits), x);
+            write(std::string_view(digits, end - digits));
+        }
+
+        void flush();
+
+        template<class T>
+        vinteger_writer& operator<<(const T& x)
+        {
+            write(x);
+            return *this;
+        }
+    };
+
+    // ****** tuning ******
+    // 算法切换阈值，单位均为计算单元数
+    // 默认值可以在构建时由 vinteger_tune 生成的头文件覆盖（CMake 变量 VINTEGER_THRESHOLDS_HEADER），
+    // 运行时第一次使用前还会读取环境变量 ALGAE_VINTEGER_THRESHOLDS 指定的配置文件，读取失败时在标准错误输出报告并使用默认值
+    struct vinteger_thresholds
+    {
+        // 乘法：两个操作数都不短于该值时使用 Karatsuba，否则使用基本乘法
+        std::size_t karatsuba = 32;
+        // 十进制转换：不超过该长度的子问题不再分治
+        std::size_t radix_leaf = 32;
+        // gcd：较大操作数不短于该值时使用 half-GCD，否则使用 Lehmer 算法
+        // 默认值取自实测：x86-64 上两种算法约在 1200~2000 个计算单元处持平
+        std::size_t half_gcd = 1500;
+        // vinteger_accumulator::addmul：较短操作数超过该值时先用快速乘法求乘积
+        std::size_t accumulator_product = 32;
+    };
+
+    // 当前生效的阈值
+    const vinteger_thresholds& thresholds();
+    // 替换当前阈值，过小的值会被调整到算法允许的下限；须在没有其他线程进行运算时调用
+    void set_thresholds(const vinteger_thresholds& value);
+    // 读取 "名称 = 值" 形式的配置文件（# 之后为注释），文件中没有出现的阈值取构建时的默认值
+    vinteger_thresholds read_thresholds(const std::string& path);
+    // 写成 read_thresholds 能读取的配置文件内容
+    std::string format_thresholds(const vinteger_thresholds& value);
+
+
+    // ****** instrumentation ******
+    // 运算计数、内存分配统计与耗时直方图
+    // 只有以 ALGAE_VINTEGER_INSTRUMENTATION 构建（CMake 选项 VINTEGER_INSTRUMENTATION）时才会记录，否则各个埋点展开为空，
+    // 下面的接口仍然可用，但统计始终为 0
+    // 计数器按线程记录，汇总时才合并；嵌套的运算（例如十进制转换中的除法）各自计数
+#if defined(ALGAE_VINTEGER_INSTRUMENTATION)
+    constexpr bool instrumentation_enabled = true;
+#else
+    constexpr bool instrumentation_enabled = false;
+#endif
+
+    enum class vinteger_operation : std::uint8_t
+    {
+        add,            // 加法与减法（adder_context）
+        multiply,       // multiplier_context
+        divide,         // 除法与取模（divider_context）
+        to_string,
+        from_string,
+    };
+    constexpr std::size_t vinteger_operation_count = 5;
+
+    enum class vinteger_algorithm : std::uint8_t
+    {
+        basecase,               // 逐字的基本乘法
+        karatsuba,
+        unit_division,          // 除数只有一个计算单元
+        knuth_division,
+        exact_division,         // divexact 的 Hensel 整除
+        radix_leaf,             // 十进制转换不分治
+        radix_divide_and_conquer,
+    };
+    constexpr std::size_t vinteger_algorithm_count = 7;
+
+    struct vinteger_operation_stats
+    {
+        std::uint64_t calls = 0;
+        // 操作数计算单元数之和
+        std::uint64_t limbs = 0;
+        std::uint64_t nanoseconds = 0;
+        // 第 i 个桶统计 bit_width 为 i 的值，即 [2^(i-1), 2^i)，第 0 个桶统计 0
+        std::array<std::uint64_t, 65> size_histogram{};
+        std::array<std::uint64_t, 65> latency_histogram{};
+        // 按 vinteger_algorithm 统计实际选用的算法
+        std::array<std::uint64_t, vinteger_algorithm_count> algorithms{};
+    };
+
+    struct vinteger_instrumentation
+    {
+        std::array<vinteger_operation_stats, vinteger_operation_count> operations{};
+        // 分配的缓冲区个数与计算单元总数，以及最后一个引用释放时归还的缓冲区个数
+        std::uint64_t allocations = 0;
+        std::uint64_t allocated_limbs = 0;
+        std::uint64_t releases = 0;
+
+        const vinteger_operation_stats& operator[](const vinteger_operation op) const {
+            return operations[std::size_t(op)];
+        }
+    };
+
+    // 汇总所有线程（包括已经退出的线程）自上次 reset_instrumentation 以来的统计
+    vinteger_instrumentation collect_instrumentation();
+    void reset_instrumentation();
+
+    // 导出回调，export_instrumentation 以汇总结果依次调用；返回的编号用于移除回调
+    using instrumentation_exporter = std::function<void(const vinteger_instrumentation&)>;
+    std::size_t add_instrumentation_exporter(instrumentation_exporter exporter);
+    void remove_instrumentation_exporter(std::size_t id);
+    void export_instrumentation();
+
+#if defined(ALGAE_VINTEGER_INSTRUMENTATION)
+    // 埋点：在作用域内计时一次运算，析构时计入当前线程的计数器
+    class __instrumentation_scope
+    {
+        vinteger_operation __operation;
+        std::size_t __limbs;
+        std::size_t __algorithm = vinteger_algorithm_count;
+        std::int64_t __start;
+        __instrumentation_scope* __parent;
+
+        friend void __instrument_algorithm(vinteger_algorithm algorithm);
+
+    public:
+        __instrumentation_scope(vinteger_operation operation, std::size_t limbs);
+        ~__instrumentation_scope();
+
+        __instrumentation_scope(const __instrumentation_scope&) = delete;
+        __instrumentation_scope& operator=(const __instrumentation_scope&) = delete;
+    };
+
+    // 为当前线程最内层的埋点作用域记录选用的算法
+    void __instrument_algorithm(vinteger_algorithm algorithm);
+    void __instrument_allocation(std::size_t limbs);
+    void __instrument_release();
+
+#define ALGAE_VINTEGER_INSTRUMENT(operation, limbs) ::algae::__instrumentation_scope __instrumentation_scope_guard(::algae::vinteger_operation::operation, limbs)
+#define ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(algorithm) ::algae::__instrument_algorithm(algorithm)
+#define ALGAE_VINTEGER_INSTRUMENT_ALLOCATION(limbs) ::algae::__instrument_allocation(limbs)
+#define ALGAE_VINTEGER_INSTRUMENT_RELEASE() ::algae::__instrument_release()
+#else
+#define ALGAE_VINTEGER_INSTRUMENT(operation, limbs) ((void)0)
+#define ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(algorithm) ((void)0)
+#define ALGAE_VINTEGER_INSTRUMENT_ALLOCATION(limbs) ((void)0)
+#define ALGAE_VINTEGER_INSTRUMENT_RELEASE() ((void)0)
+#endif
+
+
+    
+    std::istream& operator >> (std::istream& in, vinteger& arg);
+    std::ostream& operator << (std::ostream& out, const vinteger& arg);
+    
+    // 整数字面量在编译期解析为计算单元，保存在静态存储中
+    // 支持十进制、0x 十六进制、0b 二进制，以及 ' 分隔符
+    // 0 开头的数字仍按十进制解析（0123_vi == 123），与 vinteger("0123") 一致，不支持八进制
+    template<char... C>
+    struct __vinteger_literal
+    {
+        constexpr static std::array<char, sizeof...(C)> digits{C...};
+
+        constexpr static unsigned base()
+        {
+            if(digits.size() > 1 && digits[0] == '0')
+            {
+                if(digits[1] == 'x' || digits[1] == 'X')
+                    return 16;
+                if(digits[1] == 'b' || digits[1] == 'B')
+                    return 2;
+            }
+
+            return 10;
+        }
+
+        constexpr static std::size_t prefix_length = base() == 10 ? 0 : 2;
+
+        constexpr static unsigned digit_value(const char c)
+        {
+            if(c >= '0' && c <= '9')
+                return unsigned(c - '0');
+            if(c >= 'a' && c <= 'f')
+                return unsigned(c - 'a' + 10);
+            if(c >= 'A' && c <= 'F')
+                return unsigned(c - 'A' + 10);
+            return 16;
+        }
+
+        constexpr static bool valid()
+        {
+            bool any = false;
+            for(std::size_t i = prefix_length; i < digits.size(); ++i)
+            {
+                if(digits[i] == '\'')
+                    continue;
+                if(digit_value(digits[i]) >= base())
+                    return false;
+                any = true;
+            }
+
+            return any;
+        }
+
+        static_assert(valid(), "invalid integer literal");
+
+        // 每个数字至多贡献 4 个二进制位
+        constexpr static std::size_t capacity = (4 * sizeof...(C) + 63) / 64;
+
+        constexpr static std::array<std::uint64_t, capacity> parse()
+        {
+            std::array<std::uint64_t, capacity> result{};
+            for(std::size_t i = prefix_length; i < digits.size(); ++i)
+            {
+                if(digits[i] == '\'')
+                    continue;
+
+                // result = result * base + digit，按 32 位半单元相乘，不依赖 128 位整数
+                std::uint64_t carry = digit_value(digits[i]);
+                for(std::uint64_t& limb : result)
+                {
+                    const std::uint64_t low = (limb & 0xffffffff) * base() + carry;
+                    const std::uint64_t high = (limb >> 32) * base() + (low >> 32);
+                    limb = (high << 32) | (low & 0xffffffff);
+                    carry = high >> 32;
+                }
+            }
+
+            return result;
+        }
+
+        constexpr static std::array<std::uint64_t, capacity> parsed = parse();
+
+        constexpr static std::size_t length()
+        {
+            std::size_t n = capacity;
+            while(n > 0 && parsed[n - 1] == 0)
+                --n;
+
+            return n;
+        }
+
+        // 去掉高位 0 的计算单元
+        constexpr static std::array<std::uint64_t, length()> limbs = []
+        {
+            std::array<std::uint64_t, length()> result{};
+            for(std::size_t i = 0; i < result.size(); ++i)
+                result[i] = parsed[i];
+
+            return result;
+        }();
+    };
+
+    namespace vinteger_literals {
+        // 解析在编译期完成；第一次求值时复制一次计算单元，之后每次求值只共享同一个缓冲区（写时复制）
+        template<char... C>
+        vinteger operator ""_vi()
+        {
+            static const vinteger value = vinteger_view(__vinteger_literal<C...>::limbs).value();
+            return value;
+        }
+
+        // 直接借用静态存储中的计算单元，不分配内存，可以用于 constexpr 与 constinit 变量，例如大整数常量表
+        template<char... C>
+        constexpr vinteger_view operator ""_viv() {
+            return vinteger_view(__vinteger_literal<C...>::limbs);
+        }
+    }
+}
+
 #endif
\ No newline at end of file
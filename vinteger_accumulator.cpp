@@ -0,0 +1,160 @@
+#include "vinteger.h"
+#include <algorithm>
+
+namespace algae
+{
+    vinteger_accumulator::vinteger_accumulator(const vinteger& initial) {
+        add(initial);
+    }
+
+    void vinteger_accumulator::__reserve(const int side, const std::size_t length)
+    {
+        if(__low[side].size() < length)
+        {
+            __low[side].resize(length);
+            __carry[side].resize(length);
+        }
+    }
+
+    void vinteger_accumulator::__add_units(const int side, const __CUtype* units, const std::size_t length)
+    {
+        __reserve(side, length);
+
+        // 列内只做一次加法与一次比较，没有跨列依赖，编译器可以向量化
+        __CUtype* low = __low[side].data();
+        __CUtype* carry = __carry[side].data();
+        for(std::size_t i = 0; i < length; ++i)
+        {
+            low[i] += units[i];
+            carry[i] += low[i] < units[i];
+        }
+    }
+
+    void vinteger_accumulator::__add_product(const int side, const vinteger& a, const vinteger& b)
+    {
+        const std::size_t an = a.__value_length(), bn = b.__value_length();
+        __reserve(side, an + bn);
+
+        __CUtype* low = __low[side].data();
+        __CUtype* carry = __carry[side].data();
+        for(std::size_t i = 0; i < an; ++i)
+        {
+            for(std::size_t j = 0; j < bn; ++j)
+            {
+                __CUtype high;
+                const __CUtype product = vinteger::__multiply_unit(a.__buffer[i], b.__buffer[j], high);
+
+                low[i + j] += product;
+                carry[i + j] += low[i + j] < product;
+                low[i + j + 1] += high;
+                carry[i + j + 1] += low[i + j + 1] < high;
+            }
+        }
+    }
+
+    // 第 i 列的溢出次数属于第 i + 1 列；三个 64 位数之和不超过 3 * 2^64，因此链式进位不超过 2
+    vinteger vinteger_accumulator::__normalize(const int side) const
+    {
+        const std::vector<__CUtype>& low = __low[side];
+        const std::vector<__CUtype>& carry = __carry[side];
+
+        vinteger result;
+        if(low.empty())
+            return result;
+
+        const std::size_t length = low.size() + 2;
+        result.__change_capacity(length, false, true);
+
+        __CUtype chain = 0;
+        for(std::size_t i = 0; i < length; ++i)
+        {
+            const __CUtype x = i < low.size() ? low[i] : 0;
+            const __CUtype y = i > 0 && i - 1 < carry.size() ? carry[i - 1] : 0;
+
+            __CUtype sum = x + y;
+            __CUtype next = sum < x;
+            sum += chain;
+            next += sum < chain;
+
+            result.__buffer[i] = sum;
+            chain = next;
+        }
+
+        result.__refresh_bit_length(length);
+        return result;
+    }
+
+
+
+    void vinteger_accumulator::add(const vinteger& x)
+    {
+        if(!x.empty())
+            __add_units(x.sign() < 0, x.__buffer, x.__value_length());
+    }
+
+    void vinteger_accumulator::sub(const vinteger& x)
+    {
+        if(!x.empty())
+            __add_units(x.sign() > 0, x.__buffer, x.__value_length());
+    }
+
+    void vinteger_accumulator::addmul(const vinteger& a, const vinteger& b)
+    {
+        if(a.empty() || b.empty())
+            return;
+
+        // 较短操作数超过阈值时先用快速乘法求出乘积再累加，否则部分积直接逐列累加
+        if(std::min(a.__value_length(), b.__value_length()) > thresholds().accumulator_product)
+            return add(a * b);
+
+        __add_product(a.sign() != b.sign(), a, b);
+    }
+
+    void vinteger_accumulator::submul(const vinteger& a, const vinteger& b)
+    {
+        if(a.empty() || b.empty())
+            return;
+
+        if(std::min(a.__value_length(), b.__value_length()) > thresholds().accumulator_product)
+            return sub(a * b);
+
+        __add_product(a.sign() == b.sign(), a, b);
+    }
+
+    void vinteger_accumulator::merge(const vinteger_accumulator& other)
+    {
+        // 合并自身时，累加过程会改写正在读取的 __low 与 __carry，先复制一份
+        if(&other == this)
+        {
+            const vinteger_accumulator copy = other;
+            return merge(copy);
+        }
+
+        for(int side = 0; side < 2; ++side)
+        {
+            __add_units(side, other.__low[side].data(), other.__low[side].size());
+
+            // 对方的溢出次数与本方的溢出次数同属一列，直接相加
+            __CUtype* carry = __carry[side].data();
+            for(std::size_t i = 0; i < other.__carry[side].size(); ++i)
+                carry[i] += other.__carry[side][i];
+        }
+    }
+
+    void vinteger_accumulator::clear()
+    {
+        for(int side = 0; side < 2; ++side)
+        {
+            __low[side].clear();
+            __carry[side].clear();
+        }
+    }
+
+    vinteger vinteger_accumulator::value() const {
+        return __normalize(0) - __normalize(1);
+    }
+
+    vinteger_accumulator::operator vinteger() const {
+        return value();
+    }
+}
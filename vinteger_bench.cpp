@@ -0,0 +1,379 @@
+// vinteger 基准测试
+//   vinteger_bench [--max-digits N] [--ops add,mul,...] [--min-time MS] [--budget MS] [--output FILE]
+//       按操作数规模（十进制位数 19、100、1000 ... 直到 N）扫描各运算，以 JSON 输出每次运算的耗时、吞吐量与内存分配次数
+//       另外以 fixed256_* 为名测量 256 位 fixed_int 的加法、乘法、除法与十进制转换
+//   vinteger_bench --compare BASE.json NEW.json
+//       对比两次构建的输出，按运算与规模列出耗时之比
+#include "vinteger.h"
+#include "vinteger_fixed_int.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 统计全局 operator new 的调用次数，得到每次运算的内存分配次数
+static std::atomic<std::size_t> allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace
+{
+    using namespace algae;
+    using bench_clock = std::chrono::steady_clock;
+
+    struct bench_options
+    {
+        std::size_t max_digits = 10000000;
+        std::vector<std::string> ops;
+        // 每个规模至少测量的时间
+        double min_time_ms = 200;
+        // 单次运算超过这一时间后不再测量该运算更大的规模
+        double budget_ms = 5000;
+        std::string output;
+    };
+
+    struct bench_result
+    {
+        std::string op;
+        std::size_t digits = 0;
+        std::size_t limbs = 0;
+        std::size_t iterations = 0;
+        double ns_per_op = 0;
+        double limbs_per_second = 0;
+        double allocations_per_op = 0;
+    };
+
+    // 操作数：a、b 为 n 个计算单元，wide 为 2n 个计算单元（除法的被除数），text 为 a 的十进制表示
+    struct operands
+    {
+        vinteger a, b, wide;
+        std::string text;
+    };
+
+    using bench_kernel = std::function<std::size_t(operands&)>;
+
+    const std::vector<std::pair<std::string, bench_kernel>>& kernels()
+    {
+        // 返回值参与求和，避免运算被优化掉
+        static const std::vector<std::pair<std::string, bench_kernel>> list = {
+            {"add", [](operands& x) { return (x.a + x.b).value_bit_width(); }},
+            {"sub", [](operands& x) { return (x.a - x.b).value_bit_width(); }},
+            {"mul", [](operands& x) { return (x.a * x.b).value_bit_width(); }},
+            {"sqr", [](operands& x) { return (x.a * x.a).value_bit_width(); }},
+            {"div", [](operands& x) { return (x.wide / x.b).value_bit_width(); }},
+            {"mod", [](operands& x) { return (x.wide % x.b).value_bit_width(); }},
+            {"shl", [](operands& x) { return (x.a << 1000).value_bit_width(); }},
+            {"shr", [](operands& x) { return (x.a >> 1000).value_bit_width(); }},
+            {"cmp", [](operands& x) { return std::size_t(std::is_lt(x.a <=> x.b)); }},
+            {"to_string", [](operands& x) { return x.a.to_string().size(); }},
+            {"from_string", [](operands& x) { return vinteger(x.text).value_bit_width(); }},
+        };
+
+        return list;
+    }
+
+    // 定长整数：操作数固定为 256 位，只在最小的规模上测量一次，与 100 位十进制规模的 vinteger 结果对照
+    using fixed_256 = fixed_int<256>;
+    constexpr std::size_t fixed_digits = 77;
+
+    struct fixed_operands
+    {
+        fixed_256 a, b;
+    };
+
+    using fixed_kernel = std::function<std::size_t(fixed_operands&)>;
+
+    const std::vector<std::pair<std::string, fixed_kernel>>& fixed_kernels()
+    {
+        static const std::vector<std::pair<std::string, fixed_kernel>> list = {
+            {"fixed256_add", [](fixed_operands& x) { return std::size_t((x.a + x.b).limbs[0]); }},
+            {"fixed256_mul", [](fixed_operands& x) { return std::size_t((x.a * x.b).limbs[0]); }},
+            {"fixed256_div", [](fixed_operands& x) { return std::size_t((x.a / (x.b >> 64)).limbs[0]); }},
+            {"fixed256_to_string", [](fixed_operands& x) { return x.a.to_string().size(); }},
+        };
+
+        return list;
+    }
+
+    vinteger random_value(std::mt19937_64& rng, const std::size_t limbs)
+    {
+        std::vector<std::uint64_t> words(limbs);
+        for(std::uint64_t& w : words)
+            w = rng();
+
+        words.back() |= std::uint64_t(1) << 63;
+        return import_bits(words.data(), words.size(), sizeof(std::uint64_t));
+    }
+
+    std::size_t digits_to_limbs(const std::size_t digits) {
+        return std::max<std::size_t>(1, std::size_t(std::ceil(double(digits) * std::log2(10.0) / 64)));
+    }
+
+    bench_result measure(const std::string& op, const bench_kernel& kernel, operands& x, const std::size_t digits, const std::size_t limbs, const bench_options& options, std::size_t& sink)
+    {
+        // 以倍增的批量重复运算，直到总时间超过 min_time
+        std::size_t iterations = 0, batch = 1, allocations = 0;
+        double elapsed_ns = 0;
+        while(elapsed_ns < options.min_time_ms * 1e6)
+        {
+            const std::size_t allocations_before = allocation_count.load(std::memory_order_relaxed);
+            const auto start = bench_clock::now();
+            for(std::size_t i = 0; i < batch; ++i)
+                sink += kernel(x);
+
+            elapsed_ns += std::chrono::duration<double, std::nano>(bench_clock::now() - start).count();
+            allocations += allocation_count.load(std::memory_order_relaxed) - allocations_before;
+            iterations += batch;
+
+            // 单次运算已经超出预算时不再重复
+            if(elapsed_ns / iterations > options.budget_ms * 1e6)
+                break;
+
+            batch *= 2;
+        }
+
+        bench_result result;
+        result.op = op;
+        result.digits = digits;
+        result.limbs = limbs;
+        result.iterations = iterations;
+        result.ns_per_op = elapsed_ns / iterations;
+        result.limbs_per_second = limbs / (result.ns_per_op * 1e-9);
+        result.allocations_per_op = double(allocations) / iterations;
+        return result;
+    }
+
+    std::string to_json_line(const bench_result& r)
+    {
+        std::ostringstream out;
+        out << std::setprecision(6)
+            << "{\"op\": \"" << r.op << "\", \"digits\": " << r.digits << ", \"limbs\": " << r.limbs
+            << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"limbs_per_second\": " << r.limbs_per_second << ", \"allocations_per_op\": " << r.allocations_per_op << "}";
+        return out.str();
+    }
+
+    int run(const bench_options& options)
+    {
+        std::vector<std::size_t> sizes;
+        for(std::size_t digits = 19; digits <= options.max_digits; digits = digits == 19 ? 100 : digits * 10)
+            sizes.push_back(digits);
+
+        std::map<std::string, bool> over_budget;
+        std::vector<bench_result> results;
+        std::mt19937_64 rng(20240601);
+        std::size_t sink = 0;
+
+        fixed_operands fixed{fixed_256(random_value(rng, fixed_256::limb_count)), fixed_256(random_value(rng, fixed_256::limb_count))};
+        for(const auto& [op, kernel] : fixed_kernels())
+        {
+            if(!options.ops.empty() && std::find(options.ops.begin(), options.ops.end(), op) == options.ops.end())
+                continue;
+
+            operands unused;
+            const bench_kernel adapter = [&, &kernel = kernel](operands&) { return kernel(fixed); };
+            results.push_back(measure(op, adapter, unused, fixed_digits, fixed_256::limb_count, options, sink));
+            std::cerr << to_json_line(results.back()) << std::endl;
+        }
+
+        for(const std::size_t digits : sizes)
+        {
+            const std::size_t limbs = digits_to_limbs(digits);
+            operands x{random_value(rng, limbs), random_value(rng, limbs), random_value(rng, 2 * limbs), {}};
+            x.text = x.a.to_string();
+
+            for(const auto& [op, kernel] : kernels())
+            {
+                if(!options.ops.empty() && std::find(options.ops.begin(), options.ops.end(), op) == options.ops.end())
+                    continue;
+
+                if(over_budget[op])
+                    continue;
+
+                results.push_back(measure(op, kernel, x, digits, limbs, options, sink));
+                std::cerr << to_json_line(results.back()) << std::endl;
+
+                if(results.back().ns_per_op > options.budget_ms * 1e6)
+                    over_budget[op] = true;
+            }
+        }
+
+        std::ofstream file;
+        if(!options.output.empty())
+        {
+            file.open(options.output);
+            if(!file)
+                throw std::runtime_error("cannot open " + options.output);
+        }
+
+        std::ostream& out = options.output.empty() ? std::cout : file;
+        out << "{\n  \"benchmarks\": [\n";
+        for(std::size_t i = 0; i < results.size(); ++i)
+            out << "    " << to_json_line(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+
+        out << "  ],\n  \"checksum\": " << sink << "\n}\n";
+        return 0;
+    }
+
+
+
+    // 读取 run 输出的 JSON，每条结果占一行
+    std::string json_field(const std::string& line, const std::string& key)
+    {
+        const std::string pattern = "\"" + key + "\": ";
+        const std::size_t begin = line.find(pattern);
+        if(begin == std::string::npos)
+            throw std::invalid_argument("missing field " + key + " in: " + line);
+
+        std::size_t first = begin + pattern.size(), last;
+        if(line[first] == '"')
+            last = line.find('"', ++first);
+        else
+            last = line.find_first_of(",}", first);
+
+        return line.substr(first, last - first);
+    }
+
+    std::map<std::pair<std::string, std::size_t>, bench_result> load(const std::string& path)
+    {
+        std::ifstream in(path);
+        if(!in)
+            throw std::runtime_error("cannot open " + path);
+
+        std::map<std::pair<std::string, std::size_t>, bench_result> results;
+        std::string line;
+        while(std::getline(in, line))
+        {
+            if(line.find("\"op\"") == std::string::npos)
+                continue;
+
+            bench_result r;
+            r.op = json_field(line, "op");
+            r.digits = std::stoull(json_field(line, "digits"));
+            r.ns_per_op = std::stod(json_field(line, "ns_per_op"));
+            r.allocations_per_op = std::stod(json_field(line, "allocations_per_op"));
+            results[{r.op, r.digits}] = r;
+        }
+
+        return results;
+    }
+
+    int compare(const std::string& base_path, const std::string& new_path)
+    {
+        const auto base = load(base_path), current = load(new_path);
+
+        std::cout << std::left << std::setw(12) << "op" << std::right << std::setw(10) << "digits"
+                  << std::setw(16) << "base ns/op" << std::setw(16) << "new ns/op" << std::setw(10) << "speedup"
+                  << std::setw(14) << "alloc/op" << "\n";
+
+        for(const auto& [key, b] : base)
+        {
+            const auto it = current.find(key);
+            if(it == current.end())
+                continue;
+
+            const bench_result& n = it->second;
+            std::ostringstream allocations;
+            allocations << std::setprecision(3) << b.allocations_per_op << "->" << n.allocations_per_op;
+
+            std::cout << std::left << std::setw(12) << key.first << std::right << std::setw(10) << key.second
+                      << std::fixed << std::setprecision(1) << std::setw(16) << b.ns_per_op << std::setw(16) << n.ns_per_op
+                      << std::setprecision(3) << std::setw(9) << b.ns_per_op / n.ns_per_op << "x"
+                      << std::setw(14) << allocations.str() << "\n" << std::defaultfloat;
+        }
+
+        return 0;
+    }
+
+    std::vector<std::string> split(const std::string& list)
+    {
+        std::vector<std::string> result;
+        std::istringstream in(list);
+        for(std::string item; std::getline(in, item, ','); )
+            if(!item.empty())
+                result.push_back(item);
+
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        bench_options options;
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            const auto value = [&]() -> std::string {
+                if(i + 1 >= argc)
+                    throw std::invalid_argument(arg + " requires a value");
+                return argv[++i];
+            };
+
+            if(arg == "--compare")
+            {
+                if(i + 2 >= argc)
+                    throw std::invalid_argument("--compare requires two files");
+                return compare(argv[i + 1], argv[i + 2]);
+            }
+            else if(arg == "--max-digits")
+                options.max_digits = std::stoull(value());
+            else if(arg == "--ops")
+                options.ops = split(value());
+            else if(arg == "--min-time")
+                options.min_time_ms = std::stod(value());
+            else if(arg == "--budget")
+                options.budget_ms = std::stod(value());
+            else if(arg == "--output")
+                options.output = value();
+            else
+                throw std::invalid_argument("unknown argument " + arg);
+        }
+
+        return run(options);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "vinteger_bench: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,315 @@
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ALGAE_VINTEGER_BULK_IO 1
+#endif
+
+namespace algae
+{
+    struct bulk_io_context
+    {
+        // 缓冲读取时每次读入的字节数
+        constexpr static std::size_t read_chunk = std::size_t(1) << 20;
+
+        constexpr static std::uint64_t ones = 0x0101010101010101ull;
+        constexpr static std::uint64_t highs = 0x8080808080808080ull;
+
+        [[noreturn]] static void fail(const char* operation) {
+            throw std::system_error(errno, std::generic_category(), operation);
+        }
+
+        // 按小端序读取 8 个字节，使内存中靠前的字节位于低位；编译器会把它合并为一次读取
+        static std::uint64_t load(const char* p)
+        {
+            std::uint64_t word = 0;
+            for(std::size_t i = 0; i < 8; ++i)
+                word |= std::uint64_t((unsigned char)p[i]) << (8 * i);
+
+            return word;
+        }
+
+        static bool is_space(const char c) {
+            return (unsigned char)c <= ' ';
+        }
+
+        // 一次检查 8 个字节：按字节比较 <= ' '（空白与控制字符）与 > ' '，结果在每个字节的最高位
+        // 减法的借位只会影响已满足条件的字节之上的字节，因此最低的置位字节总是第一个满足条件的字节
+        static std::uint64_t space_mask(const std::uint64_t word) {
+            return (word - ones * 0x21) & ~word & highs;
+        }
+
+        static std::uint64_t non_space_mask(const std::uint64_t word) {
+            return (((word & ~highs) + ones * (0x7f - 0x20)) | word) & highs;
+        }
+
+        // 跳过空白，返回第一个非空白字符的位置，没有时返回 end
+        static const char* skip_space(const char* p, const char* end)
+        {
+            for(; end - p >= 8; p += 8)
+                if(const std::uint64_t mask = non_space_mask(load(p)))
+                    return p + std::countr_zero(mask) / 8;
+
+            while(p != end && is_space(*p))
+                ++p;
+
+            return p;
+        }
+
+        // 返回第一个空白字符的位置，没有时返回 end
+        static const char* find_space(const char* p, const char* end)
+        {
+            for(; end - p >= 8; p += 8)
+                if(const std::uint64_t mask = space_mask(load(p)))
+                    return p + std::countr_zero(mask) / 8;
+
+            while(p != end && !is_space(*p))
+                ++p;
+
+            return p;
+        }
+    };
+
+
+
+    vinteger_reader::vinteger_reader(const int fd) {
+        __open(fd);
+    }
+
+    std::string_view vinteger_reader::token()
+    {
+        // 跳过空白，缓冲区读完时读入下一块
+        while((__begin = bulk_io_context::skip_space(__begin, __end)) == __end)
+            if(!__refill())
+                return {};
+
+        // 词元可能跨越缓冲块的边界，__refill 保留尚未读取的部分，因此已扫描的长度保持有效
+        std::size_t length = 0;
+        do
+            length = bulk_io_context::find_space(__begin + length, __end) - __begin;
+        while(__begin + length == __end && __refill());
+
+        const std::string_view result(__begin, length);
+        __begin += length;
+        return result;
+    }
+
+    bool vinteger_reader::read(vinteger& x)
+    {
+        const std::string_view t = token();
+        if(t.empty())
+            return false;
+
+        x = vinteger(t);
+        return true;
+    }
+
+
+
+    vinteger_writer::~vinteger_writer()
+    {
+        // 析构函数中不能抛出异常，写出失败时丢弃剩余内容；需要检查错误时应先调用 flush
+        try
+        {
+            flush();
+        }
+        catch(...)
+        {
+        }
+
+#if defined(ALGAE_VINTEGER_BULK_IO)
+        if(__owns_fd)
+            ::close(__fd);
+#endif
+    }
+
+    void vinteger_writer::write(const vinteger& x)
+    {
+        const std::size_t width = __decimal_width(x);
+        if(width > __buffer.size() - __size)
+            flush();
+
+        // 超出缓冲区容量的数值单独转换后直接写出
+        if(width > __buffer.size())
+        {
+            const std::string s = x.to_string();
+            return __write_all(s.data(), s.size());
+        }
+
+        __size += __write_decimal(x, __buffer.data() + __size, exec_policy{1});
+    }
+
+    void vinteger_writer::write(const std::string_view s)
+    {
+        if(s.size() > __buffer.size() - __size)
+            flush();
+
+        if(s.size() > __buffer.size())
+            return __write_all(s.data(), s.size());
+
+        std::memcpy(__buffer.data() + __size, s.data(), s.size());
+        __size += s.size();
+    }
+
+    void vinteger_writer::write(const char c)
+    {
+        if(__size == __buffer.size())
+            flush();
+
+        __buffer[__size++] = c;
+    }
+
+    void vinteger_writer::flush()
+    {
+        // 先清空缓冲区，写出失败时异常不会导致同一段内容在析构时再次写出
+        const std::size_t size = std::exchange(__size, 0);
+        __write_all(__buffer.data(), size);
+    }
+
+
+
+#if defined(ALGAE_VINTEGER_BULK_IO)
+    vinteger_reader::vinteger_reader(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            bulk_io_context::fail("open");
+
+        __owns_fd = true;
+        try
+        {
+            __open(fd);
+        }
+        catch(...)
+        {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    vinteger_reader::~vinteger_reader()
+    {
+        if(__mapping)
+            ::munmap(__mapping, __mapping_size);
+
+        if(__owns_fd)
+            ::close(__fd);
+    }
+
+    void vinteger_reader::__open(const int fd)
+    {
+        __fd = fd;
+
+        // 普通文件从当前位置起整体映射，映射失败时退回缓冲读取
+        struct stat status;
+        const off_t position = ::lseek(fd, 0, SEEK_CUR);
+        if(::fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && position >= 0 && status.st_size > position)
+        {
+            void* mapping = ::mmap(nullptr, std::size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping != MAP_FAILED)
+            {
+                ::madvise(mapping, std::size_t(status.st_size), MADV_SEQUENTIAL);
+                __mapping = mapping;
+                __mapping_size = std::size_t(status.st_size);
+                __begin = static_cast<const char*>(mapping) + position;
+                __end = static_cast<const char*>(mapping) + __mapping_size;
+                return;
+            }
+        }
+
+        __buffer.resize(bulk_io_context::read_chunk);
+        __begin = __end = __buffer.data();
+    }
+
+    // 保留尚未读取的部分并移到缓冲区开头，再读入一块；返回读入的字节数，输入结束时返回 0
+    std::size_t vinteger_reader::__refill()
+    {
+        if(__mapping)
+            return 0;
+
+        const std::size_t kept = __end - __begin;
+        if(__begin != __buffer.data())
+            std::memmove(__buffer.data(), __begin, kept);
+
+        // 单个词元超过缓冲区时成倍扩大缓冲区
+        if(__buffer.size() - kept < bulk_io_context::read_chunk)
+            __buffer.resize(std::max(kept + bulk_io_context::read_chunk, __buffer.size() * 2));
+
+        ssize_t count;
+        do
+            count = ::read(__fd, __buffer.data() + kept, __buffer.size() - kept);
+        while(count < 0 && errno == EINTR);
+
+        if(count < 0)
+            bulk_io_context::fail("read");
+
+        __begin = __buffer.data();
+        __end = __begin + kept + count;
+        return std::size_t(count);
+    }
+
+    vinteger_writer::vinteger_writer(const int fd, const std::size_t buffer_size)
+        :__fd(fd), __buffer(std::max<std::size_t>(buffer_size, 1))
+    {}
+
+    vinteger_writer::vinteger_writer(const std::string& path, const std::size_t buffer_size)
+        :__buffer(std::max<std::size_t>(buffer_size, 1))
+    {
+        __fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(__fd < 0)
+            bulk_io_context::fail("open");
+
+        __owns_fd = true;
+    }
+
+    void vinteger_writer::__write_all(const char* data, std::size_t size)
+    {
+        while(size > 0)
+        {
+            const ssize_t count = ::write(__fd, data, size);
+            if(count < 0 && errno == EINTR)
+                continue;
+
+            if(count < 0)
+                bulk_io_context::fail("write");
+
+            data += count;
+            size -= std::size_t(count);
+        }
+    }
+#else
+    vinteger_reader::vinteger_reader(const std::string&) {
+        throw std::runtime_error("bulk I/O is not supported on this platform");
+    }
+
+    vinteger_reader::~vinteger_reader() = default;
+
+    void vinteger_reader::__open(int) {
+        throw std::runtime_error("bulk I/O is not supported on this platform");
+    }
+
+    std::size_t vinteger_reader::__refill() {
+        return 0;
+    }
+
+    vinteger_writer::vinteger_writer(int, std::size_t) {
+        throw std::runtime_error("bulk I/O is not supported on this platform");
+    }
+
+    vinteger_writer::vinteger_writer(const std::string&, std::size_t) {
+        throw std::runtime_error("bulk I/O is not supported on this platform");
+    }
+
+    void vinteger_writer::__write_all(const char*, std::size_t) {
+        throw std::runtime_error("bulk I/O is not supported on this platform");
+    }
+#endif
+}
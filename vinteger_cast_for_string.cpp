@@ -1,366 +1,320 @@
-#include "vinteger.h"
-#include <algorithm>
-#include <stdexcept>
-#include <cstring>
-#include <vector>
-#include <limits>
-
-namespace algae
-{
-    // 转换标准数，用于在高精度整数转换过程中作为转换标准
-    class cast_standard
-    {
-        private:
-            // 初始化溢出边界的静态常量表达式函数
-            // 计算 10 的 std::numeric_limits<std::uint64_t>::digits10 次幂
-            static constexpr std::uint64_t init_overflow_bound()
-            {
-                std::uint64_t l = 1;
-
-                for(int i = 0; i < std::numeric_limits<std::uint64_t>::digits10; ++i)
-                    l *= 10;
-
-                return l;
-            }
-
-        public:
-            // 静态成员变量，溢出边界，即 10 的 std::numeric_limits<std::uint64_t>::digits10 次幂
-            static std::uint64_t overflow_bound;
-            // 静态成员变量，溢出边界的一半
-            static std::uint64_t half_overflow_bound;
-
-            // 存储以 10^19 进制表示的转换标准数的值
-            std::vector<std::uint64_t> buffer;
-            // 当前转换标准数对应的 2 的幂次，初始为 64
-            std::size_t count = 64;
-
-            // 构造函数，初始化转换标准数为 2^64 的 10^19 进制表示
-            cast_standard() 
-                : buffer({std::numeric_limits<std::uint64_t>::max() % overflow_bound + 1,
-                        std::numeric_limits<std::uint64_t>::max() / overflow_bound})
-            {}
-
-            // 获取转换标准数的长度（以 10^19 进制表示）
-            std::size_t length() const {
-                return buffer.size();
-            }
-
-            // 获取转换标准数以 2^64 进制表示时所需的数组长度
-            std::size_t binary_length() const {
-                return bit_width() / 64 + bool(bit_width() % 64);
-            }
-
-            // 获取转换标准数的二进制位宽
-            std::size_t bit_width() const {
-                return count + 1;
-            }
-
-            // 获取转换标准数对应的 2 的幂次
-            std::size_t power_of_2() const {
-                return count;
-            }
-
-            // 将转换标准数乘以 2 的函数
-            void mul2()
-            {
-                // 进位标志
-                bool carry = false;
-
-                // 遍历 buffer 中的每个元素，进行乘以 2 的操作
-                for(auto& i : buffer)
-                {
-                    // 判断当前元素是否大于等于溢出边界的一半
-                    bool carry_out = i >= half_overflow_bound;
-                    // 计算乘以 2 后的结果，并加上进位
-                    i = (carry_out ? (i - half_overflow_bound) : i) * 2 + carry;
-                    // 更新进位标志
-                    carry = carry_out;
-                }
-
-                // 如果最后还有进位，将进位添加到 buffer 的末尾
-                if(carry)
-                    buffer.push_back(carry);
-
-                // 更新 2 的幂次
-                ++count;
-            }
-
-            // 将转换标准数除以 2 的函数
-            void div2()
-            {
-                // 借位标志
-                bool retreat = false;
-
-                // 逆序遍历 buffer 中的每个元素，进行除以 2 的操作
-                std::for_each(buffer.rbegin(), buffer.rend(), [&](std::uint64_t& i) 
-                {
-                    // 判断当前元素是否为奇数
-                    bool retreat_out = i & 1;
-                    // 计算除以 2 后的结果，并处理借位
-                    i = retreat ? (i / 2) + half_overflow_bound : i / 2;
-                    // 更新借位标志
-                    retreat = retreat_out;
-                });
-
-                // 移除 buffer 末尾的零元素
-                while(buffer.back() == 0)
-                    buffer.pop_back();
-
-                // 更新 2 的幂次
-                --count;
-            }
-    };
-
-    // 转换中间态类，用于在高精度整数转换过程中作为中间状态
-    class intermediate_state_integer 
-    {
-        public:
-            // 存储以 10^19 进制表示的中间态整数的绝对值
-            std::uint64_t * buffer = nullptr;
-            // 中间态整数的长度（以 10^19 进制表示）
-            std::uint32_t length = 0;
-            // 中间态整数的符号，true 表示负数，false 表示正数
-            bool sign = false;
-
-        private:
-            // 分配 std::uint64_t 类型内存的函数
-            static std::uint64_t * make_int64_memory(const std::size_t n) 
-            {
-                // 分配 n 个 std::uint64_t 类型的内存空间
-                auto memory = new std::uint64_t[n];
-                // 将分配的内存空间初始化为 0
-                std::memset(memory, 0, n * sizeof(std::uint64_t));
-                return memory;
-            }
-
-            // 获取指定位的值的函数
-            inline bool bitget(const std::uint8_t * memory, std::size_t index) {
-                return memory[index / 8] & (1 << (index % 8));
-            }
-
-            // 带进位加法函数，用于计算两个 64 位无符号整数的加法，并处理进位
-            inline static std::uint64_t add_with_carry(std::uint64_t a, std::uint64_t b, bool& carry) 
-            {
-                // 先将进位加到加数上
-                a += carry;
-                // 判断是否需要进位
-                carry = a >= cast_standard::overflow_bound - b;
-                // 根据是否进位返回计算结果
-                return carry ? a - (cast_standard::overflow_bound - b) : a + b;
-            }
-
-        public:
-            // 构造函数，接受一个 vinteger 对象作为参数，将其转换为中间态整数
-            intermediate_state_integer(const vinteger& source)
-            {
-                // 分配内存空间，用于存储中间态整数
-                buffer = make_int64_memory(std::max(std::size_t((source.__value_length() * 64 * 0.3010) / 8 + 1), std::size_t(2)));
-                // 获取源 vinteger 对象的符号
-                sign = source.__bit_length < 0;
-
-                // 处理低位部分
-                buffer[0] = source.__buffer[0] % cast_standard::overflow_bound;
-                buffer[1] = source.__buffer[0] / cast_standard::overflow_bound;
-                // 更新长度
-                length = buffer[1] != 0 ? 2 : 1;
-
-                // 遍历源 vinteger 对象的每一位
-                for(cast_standard standard; standard.power_of_2() < source.value_bit_width(); standard.mul2())
-                {
-                    // 进位标志
-                    bool carry = false;
-                    // 若该位为 1
-                    if(bitget((const std::uint8_t*)source.__buffer, standard.power_of_2()))
-                    {
-                        // 逐位相加
-                        for(std::size_t i = 0; i < standard.length(); ++i)
-                            buffer[i] = add_with_carry(buffer[i], standard.buffer[i], carry);
-                        
-                        // 处理进位
-                        buffer[standard.length()] += carry;
-                        // 更新长度
-                        length = std::max((std::uint32_t)standard.length() + carry, length);
-                    }
-                }
-            }
-
-            // 将中间态整数转换为 10 进制字符串的函数
-            std::string convert_to_string()
-            {
-                // 存储结果的字符串
-                std::string result;
-                result.reserve(length * 19 + sign);
-
-                // 前缀零标志
-                bool prefix_zeros = true;
-
-                // 若为负数，添加负号
-                if(sign)
-                    result += '-';
-
-                // 从高位到低位遍历中间态整数
-                for(std::int64_t i = length - 1; i >= 0; --i)
-                {
-                    // 用于逐位提取数字的移位变量
-                    for(std::uint64_t c = buffer[i], shift = cast_standard::overflow_bound / 10; shift >= 1; shift /= 10)
-                    {
-                        // 提取当前位的数字
-                        std::uint8_t r = c / shift;
-                        // 若为前缀零，跳过
-                        if(r == 0 && prefix_zeros)
-                            continue;
-                        
-                        // 标记前缀零结束
-                        prefix_zeros = false;
-                        // 将数字转换为字符并添加到结果字符串中
-                        result += r + '0';
-                        // 更新当前值
-                        c %= shift;
-                    }
-                }
-
-            // 返回结果字符串
-            return result;
-        }
-    };
-
-    std::uint64_t cast_standard::overflow_bound = cast_standard::init_overflow_bound();
-    std::uint64_t cast_standard::half_overflow_bound = cast_standard::overflow_bound / 2;
-
-
-    std::string vinteger::to_string() const
-    {
-        if(empty())
-            return "0";
-
-        return intermediate_state_integer(*this).convert_to_string();
-    }
-
-    vinteger::operator std::string() const {
-        return to_string();
-    }
-
-
-    extern std::int64_t __set_int_sign(const std::uint64_t x, int sign);
-
-    int __legitimacy_testing(std::string_view source)
-    {
-        // 若输入字符串为空，抛出无效参数异常
-        if(source.empty())
-            throw std::invalid_argument("source is empty");
-
-        // 检查字符串的第一个字符是否为负号，若是则标记为负数
-        int sign = source[0] == '-' ? -1 : 1;
-        // 若第一个字符既不是正负号也不是数字，抛出无效参数异常
-        if(!(source[0] == '-' || source[0] == '+' || std::isdigit(source[0])))
-            throw std::invalid_argument("source is not a valid integer");
-        
-        // 遍历字符串的剩余部分，检查是否都是数字
-        for(size_t i = 1; i < source.size(); i++)
-            if(!std::isdigit(source[i]))
-                throw std::invalid_argument("source is not a valid integer");
-
-        return sign;
-    }
-
-    // 移除字符串前缀零的函数
-    std::string_view __remove_prefix_zeros(std::string_view source)
-    {
-        // 遍历字符串，找到第一个非零字符
-        for(std::size_t i = std::isdigit(source.front()) ? 0 : 1; i < source.size(); ++i)
-        {
-            if(source[i] != '0')
-                return source.substr(i);
-        }
-
-        // 若字符串全为零，返回空字符串
-        return "";
-    }
-
-    vinteger::vinteger(std::string_view source)
-    {
-#if 1
-        int sign = __legitimacy_testing(source);
-        std::string_view copy = __remove_prefix_zeros(source);
-
-        if(copy.empty())
-            return;
-
-        __HCUtype temporary = 0, shift = 1;
-        constexpr static __HCUtype overflow_bound = 1000000000;
-        auto it = copy.begin();
-
-        for(;it != copy.end() && shift < overflow_bound; ++it)
-        {
-            if(shift != 1)
-                temporary *= 10;
-
-            temporary += (*it - '0');
-            shift *= 10;
-        }
-
-        *this += temporary;
-        temporary = 0, shift = 1;
-
-        for(; it != copy.end(); ++it)
-        {
-            if(shift == overflow_bound)
-            {
-                *this *= overflow_bound;
-                *this += temporary;
-                temporary = 0, shift = 1;
-            }
-
-            if(shift != 1)
-                temporary *= 10;
-
-            temporary += (*it - '0');
-            shift *= 10;
-        }
-
-        *this *= shift;
-        *this += temporary;
-
-        __bit_length = __set_int_sign(__bit_length, sign);
-
-#else
-        int sign = __legitimacy_testing(source);
-        std::string_view copy = __remove_prefix_zeros(source);
-
-        if(copy.empty())
-            return;
-
-        *this += (copy.front() - '0');
-
-        for(auto it = copy.begin() + 1; it != copy.end(); ++it)
-        {
-            *this *= 10;
-            *this += (*it - '0');
-        }
-
-        __bit_length = __set_int_sign(__bit_length, sign);
-#endif
-    }
-
-
-    std::istream& operator >> (std::istream& in, vinteger& arg)
-    {
-        std::string s;
-        in >> s;
-        arg = vinteger(s);
-        return in;
-    }
-
-    std::ostream& operator << (std::ostream& out, const vinteger& arg)
-    {
-        out << arg.to_string();
-        return out;
-    }
-
-    namespace vinteger_literals
-    {
-        vinteger operator ""_vi(const char* x) {
-            return vinteger(x);
-        }
-    }
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace algae
+{
+    // 十进制与二进制互相转换的上下文
+    // 两个方向都按 10^(19 * 2^i) 分治：x = high * 10^k + low，high 与 low 是互不相关的子问题
+    // 转为字符串时，每个子问题写入预先分配的输出缓冲区中互不重叠的区间；解析字符串时，两半分别解析后再乘加合并
+    // 规模足够大且策略允许多线程时，两个子问题作为任务交给线程池
+    // 整个递归共用一个上下文，各节点的线程预算作为参数向下传递
+    struct radix_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        // 一个计算单元能容纳的最大的 10 的幂，恰好大于 2^63，因此作为除数时已经规格化
+        constexpr static __CUtype chunk_base = 10000000000000000000ull;
+        constexpr static std::size_t chunk_digits = 19;
+
+        // 不超过该长度的子问题直接用计算单元的乘除处理，见 vinteger_thresholds::radix_leaf
+        static std::size_t leaf_units() {
+            return thresholds().radix_leaf;
+        }
+
+        static std::size_t leaf_digits() {
+            return leaf_units() * chunk_digits;
+        }
+
+        // 整个转换的线程预算，递归入口以此作为 threads 参数
+        std::size_t threads = 1;
+        std::size_t grain = 0;
+
+        // powers[i] = 10^(19 * 2^i)
+        std::vector<vinteger> powers;
+
+        radix_context(const std::size_t digits, const exec_policy& policy)
+            :threads(__policy_threads(policy)), grain(policy.grain)
+        {
+            powers.emplace_back(chunk_base);
+            while((chunk_digits << powers.size()) < digits)
+                powers.push_back(mul(powers.back(), powers.back(), exec_policy{threads, grain}));
+        }
+
+        // 选取 10^(19 * 2^i) < 10^digits 中最大的一个作为拆分点
+        std::size_t split_index(const std::size_t digits) const
+        {
+            std::size_t i = 0;
+            while(i + 1 < powers.size() && (chunk_digits << (i + 1)) < digits)
+                ++i;
+
+            return i;
+        }
+
+        // 按线程预算并行或串行执行两个子问题，只有并行时才包装为任务
+        template<typename High, typename Low>
+        void invoke(const std::size_t size, const std::size_t threads, High&& high, Low&& low) const
+        {
+            if(threads > 1 && size >= grain)
+            {
+                std::vector<std::function<void()>> tasks;
+                tasks.emplace_back([&] { high(threads - threads / 2); });
+                tasks.emplace_back([&] { low(threads / 2); });
+                __parallel_invoke(tasks);
+            }
+            else
+                high(threads), low(threads);
+        }
+
+
+
+        // 将 x（非负）写为恰好 width 位的十进制数，不足时补前导 0，x 须小于 10^width
+        void write(const vinteger& x, char* out, const std::size_t width, const std::size_t threads) const
+        {
+            if(x.__value_length() <= leaf_units())
+                return write_leaf(x, out, width);
+
+            const std::size_t i = split_index(width);
+            const std::size_t low_width = chunk_digits << i;
+
+            vinteger high, low;
+            __divmod(x, powers[i], high, low);
+
+            invoke(x.__value_length(), threads,
+                [&](std::size_t budget) { write(high, out, width - low_width, budget); },
+                [&](std::size_t budget) { write(low, out + width - low_width, low_width, budget); });
+        }
+
+        // 叶子：反复除以 10^19，从低位到高位每次写出 19 位
+        // 短的数在栈上做除法，避免逐个输出大量小数值时的内存分配
+        static void write_leaf(const vinteger& x, char* out, std::size_t width)
+        {
+            std::size_t n = x.__value_length();
+            __CUtype local[8];
+            std::vector<__CUtype> heap;
+            __CUtype* units = local;
+            if(n > std::size(local))
+                heap.resize(n), units = heap.data();
+            std::copy(x.__buffer, x.__buffer + n, units);
+
+            while(width > 0)
+            {
+                __CUtype r = 0;
+                for(std::size_t i = n; i-- > 0; )
+                    units[i] = vinteger::__divide_unit(r, units[i], chunk_base, r);
+
+                while(n > 0 && units[n - 1] == 0)
+                    --n;
+
+                for(std::size_t j = 0; j < chunk_digits && width > 0; ++j, r /= 10)
+                    out[--width] = char('0' + r % 10);
+            }
+        }
+
+
+
+        // 解析纯数字串
+        vinteger parse(const std::string_view digits, const std::size_t threads) const
+        {
+            if(digits.size() <= leaf_digits())
+                return parse_leaf(digits);
+
+            const std::size_t i = split_index(digits.size());
+            const std::size_t low_width = chunk_digits << i;
+
+            vinteger high, low;
+            invoke(digits.size() / chunk_digits, threads,
+                [&](std::size_t budget) { high = parse(digits.substr(0, digits.size() - low_width), budget); },
+                [&](std::size_t budget) { low = parse(digits.substr(digits.size() - low_width), budget); });
+
+            return mul(high, powers[i], exec_policy{threads, grain}) + low;
+        }
+
+        // 叶子：每 19 位为一组，在计算单元数组上做乘 10^19 加组值
+        static vinteger parse_leaf(const std::string_view digits)
+        {
+            std::vector<__CUtype> units;
+            std::size_t position = 0;
+
+            while(position < digits.size())
+            {
+                // 第一组取余下的位数，使其后各组恰好 19 位
+                const std::size_t count = position == 0 && digits.size() % chunk_digits ? digits.size() % chunk_digits : chunk_digits;
+
+                __CUtype chunk = 0, scale = 1;
+                for(std::size_t j = 0; j < count; ++j)
+                    chunk = chunk * 10 + __CUtype(digits[position + j] - '0'), scale *= 10;
+                position += count;
+
+                __CUtype carry = chunk;
+                for(__CUtype& unit : units)
+                {
+                    __CUtype high;
+                    __CUtype low = vinteger::__multiply_unit(unit, scale, high);
+                    low += carry, high += low < carry;
+                    unit = low, carry = high;
+                }
+
+                if(carry)
+                    units.push_back(carry);
+            }
+
+            vinteger result;
+            if(units.empty())
+                return result;
+
+            result.__change_capacity(units.size());
+            std::copy(units.begin(), units.end(), result.__buffer);
+            result.__refresh_bit_length(units.size());
+            return result;
+        }
+    };
+
+
+    std::string vinteger::to_string() const {
+        return to_string(exec_policy{1});
+    }
+
+    // x 的十进制表示（包括负号）长度的上界
+    std::size_t __decimal_width(const vinteger& x)
+    {
+        // log10(2) < 0.30103，由此得到十进制位数的上界
+        return x.value_bit_width() * 30103 / 100000 + 1 + (x.sign() < 0);
+    }
+
+    // 将 x 的十进制表示写入 out，out 至少容纳 __decimal_width(x) 个字符，返回写出的字符数
+    std::size_t __write_decimal(const vinteger& x, char* out, const exec_policy& policy)
+    {
+        if(x.empty())
+        {
+            out[0] = '0';
+            return 1;
+        }
+
+        ALGAE_VINTEGER_INSTRUMENT(to_string, x.__value_length());
+        ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(x.__value_length() <= radix_context::leaf_units() ? vinteger_algorithm::radix_leaf : vinteger_algorithm::radix_divide_and_conquer);
+
+        const bool negative = x.sign() < 0;
+        const std::size_t width = __decimal_width(x) - negative;
+        char* digits = out + negative;
+
+        // 叶子规模直接转换绝对值，不构造转换上下文与负数的副本
+        if(x.__value_length() <= radix_context::leaf_units())
+            radix_context::write_leaf(x, digits, width);
+        else
+        {
+            const radix_context context(width, policy);
+            context.write(negative ? -x : x, digits, width, context.threads);
+        }
+
+        // 上界多出的前导 0 在原地去掉
+        const std::size_t zeros = std::find_if(digits, digits + width - 1, [](char c) { return c != '0'; }) - digits;
+        std::memmove(digits, digits + zeros, width - zeros);
+        if(negative)
+            out[0] = '-';
+
+        return width - zeros + negative;
+    }
+
+    std::string vinteger::to_string(const exec_policy& policy) const
+    {
+        std::string result(__decimal_width(*this), '0');
+        result.resize(__write_decimal(*this, result.data(), policy));
+        return result;
+    }
+
+    vinteger::operator std::string() const {
+        return to_string();
+    }
+
+
+    int __legitimacy_testing(std::string_view source)
+    {
+        // 若输入字符串为空，抛出无效参数异常
+        if(source.empty())
+            throw std::invalid_argument("source is empty");
+
+        // 检查字符串的第一个字符是否为负号，若是则标记为负数
+        int sign = source[0] == '-' ? -1 : 1;
+        // 若第一个字符既不是正负号也不是数字，抛出无效参数异常
+        if(!(source[0] == '-' || source[0] == '+' || std::isdigit(source[0])))
+            throw std::invalid_argument("source is not a valid integer");
+        
+        // 遍历字符串的剩余部分，检查是否都是数字
+        for(size_t i = 1; i < source.size(); i++)
+            if(!std::isdigit(source[i]))
+                throw std::invalid_argument("source is not a valid integer");
+
+        return sign;
+    }
+
+    // 移除字符串前缀零的函数
+    std::string_view __remove_prefix_zeros(std::string_view source)
+    {
+        // 遍历字符串，找到第一个非零字符
+        for(std::size_t i = std::isdigit(source.front()) ? 0 : 1; i < source.size(); ++i)
+        {
+            if(source[i] != '0')
+                return source.substr(i);
+        }
+
+        // 若字符串全为零，返回空字符串
+        return "";
+    }
+
+    vinteger::vinteger(std::string_view source)
+        : vinteger(source, exec_policy{1})
+    {}
+
+    vinteger::vinteger(std::string_view source, const exec_policy& policy)
+    {
+        int sign = __legitimacy_testing(source);
+        std::string_view copy = __remove_prefix_zeros(source);
+
+        if(copy.empty())
+            return;
+
+        ALGAE_VINTEGER_INSTRUMENT(from_string, (copy.size() + radix_context::chunk_digits - 1) / radix_context::chunk_digits);
+        ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(copy.size() <= radix_context::leaf_digits() ? vinteger_algorithm::radix_leaf : vinteger_algorithm::radix_divide_and_conquer);
+
+        // 不超过 19 位的数直接由一个计算单元表示，叶子规模不构造转换上下文
+        if(copy.size() <= radix_context::chunk_digits)
+        {
+            __CUtype value = 0;
+            for(const char c : copy)
+                value = value * 10 + __CUtype(c - '0');
+
+            __initialization_by_cinteger(value);
+        }
+        else if(copy.size() <= radix_context::leaf_digits())
+            *this = radix_context::parse_leaf(copy);
+        else
+        {
+            const radix_context context(copy.size(), policy);
+            *this = context.parse(copy, context.threads);
+        }
+
+        __bit_length = __set_int_sign(__bit_length, sign);
+    }
+
+
+    std::istream& operator >> (std::istream& in, vinteger& arg)
+    {
+        // 读取失败（如输入结束）时保持 arg 不变，由流的状态报告
+        std::string s;
+        if(in >> s)
+            arg = vinteger(s);
+
+        return in;
+    }
+
+    std::ostream& operator << (std::ostream& out, const vinteger& arg)
+    {
+        out << arg.to_string();
+        return out;
+    }
 }
\ No newline at end of file
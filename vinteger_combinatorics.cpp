@@ -0,0 +1,199 @@
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace algae
+{
+    // 埃氏筛，返回不超过 n 的所有素数
+    // 只筛奇数，下标 i 对应奇数 2i + 1
+    std::vector<std::uint32_t> __prime_sieve(const std::uint64_t n)
+    {
+        if(n > std::numeric_limits<std::uint32_t>::max())
+            throw std::invalid_argument("sieve bound is too large");
+
+        std::vector<std::uint32_t> primes;
+        if(n < 2)
+            return primes;
+
+        primes.push_back(2);
+
+        const std::size_t half = (n - 1) / 2;
+        std::vector<bool> composite(half + 1, false);
+
+        for(std::size_t i = 1; i <= half; ++i)
+        {
+            if(composite[i])
+                continue;
+
+            const std::uint64_t p = 2 * i + 1;
+            primes.push_back(std::uint32_t(p));
+
+            for(std::uint64_t j = p * p / 2; j <= half; j += p)
+                composite[j] = true;
+        }
+
+        return primes;
+    }
+
+    // 平衡乘积树：将区间一分为二递归相乘，使每次乘法的两个操作数规模接近
+    vinteger __product_tree(const vinteger* factors, const std::size_t count)
+    {
+        if(count == 0)
+            return 1;
+
+        if(count == 1)
+            return factors[0];
+
+        if(count == 2)
+            return factors[0] * factors[1];
+
+        const std::size_t half = count / 2;
+        return __product_tree(factors, half) * __product_tree(factors + half, count - half);
+    }
+
+    // 将单计算单元因子贪心地打包，使每个叶子尽量填满一个计算单元，再交给乘积树
+    vinteger __product_of_units(const std::vector<std::uint64_t>& factors)
+    {
+        std::vector<vinteger> leaves;
+        std::uint64_t packed = 1;
+
+        for(const std::uint64_t x : factors)
+        {
+            if(x == 0)
+                return 0;
+
+            if(packed > std::numeric_limits<std::uint64_t>::max() / x)
+            {
+                leaves.emplace_back(packed);
+                packed = 1;
+            }
+
+            packed *= x;
+        }
+
+        if(packed != 1 || leaves.empty())
+            leaves.emplace_back(packed);
+
+        return __product_tree(leaves.data(), leaves.size());
+    }
+
+
+
+    vinteger pow(const vinteger& base, std::uint64_t exponent)
+    {
+        if(exponent == 0)
+            return 1;
+
+        if(base.empty())
+            return 0;
+
+        // 底数为 2 的幂时直接移位
+        if(base.value_bit_width() > 1 && std::is_eq((base.sign() > 0 ? base : -base) <=> (vinteger(1) << (base.value_bit_width() - 1))))
+        {
+            vinteger result = vinteger(1) << ((base.value_bit_width() - 1) * exponent);
+            return (base.sign() < 0 && exponent % 2) ? -result : result;
+        }
+
+        vinteger result = base;
+        for(int i = std::bit_width(exponent) - 2; i >= 0; --i)
+        {
+            result = result * result;
+
+            if(exponent >> i & 1)
+                result = result * base;
+        }
+
+        return result;
+    }
+
+
+
+    // 奇数部分的素数摆动：n! / ((n / 2)!)^2 去掉 2 的因子
+    // 素数 p 的指数等于 n / p^i (i >= 1) 中奇数的个数
+    static vinteger __odd_swing(const std::uint64_t n, const std::vector<std::uint32_t>& primes)
+    {
+        std::vector<std::uint64_t> factors;
+
+        for(std::size_t i = 1; i < primes.size() && primes[i] <= n; ++i)
+        {
+            const std::uint64_t p = primes[i];
+            std::uint64_t power = 1;
+
+            for(std::uint64_t q = n / p; q > 0; q /= p)
+                if(q & 1)
+                    power *= p;
+
+            if(power > 1)
+                factors.push_back(power);
+        }
+
+        return __product_of_units(factors);
+    }
+
+    static vinteger __odd_factorial(const std::uint64_t n, const std::vector<std::uint32_t>& primes)
+    {
+        if(n < 2)
+            return 1;
+
+        vinteger half = __odd_factorial(n / 2, primes);
+        return half * half * __odd_swing(n, primes);
+    }
+
+    vinteger factorial(std::uint64_t n)
+    {
+        if(n < 2)
+            return 1;
+
+        // n! 中 2 的指数为 n - popcount(n)，最后统一移位
+        return __odd_factorial(n, __prime_sieve(n)) << (n - std::popcount(n));
+    }
+
+
+
+    vinteger binomial(std::uint64_t n, std::uint64_t k)
+    {
+        if(k > n)
+            return 0;
+
+        k = std::min(k, n - k);
+        if(k == 0)
+            return 1;
+
+        // k 较小或 n 超出筛法范围时，逐项乘除，每一步的商都是整数
+        constexpr std::uint64_t small_k = 32;
+        constexpr std::uint64_t sieve_bound = std::uint64_t(1) << 28;
+
+        if(k <= small_k || n > sieve_bound)
+        {
+            vinteger result = 1;
+            for(std::uint64_t i = 1; i <= k; ++i)
+                result = divexact(result * (n - k + i), i);
+
+            return result;
+        }
+
+        // Kummer 定理：p 的指数等于 k 与 n - k 在 p 进制下相加的进位次数
+        std::vector<std::uint64_t> factors;
+        for(const std::uint64_t p : __prime_sieve(n))
+        {
+            std::uint64_t power = 1;
+
+            for(std::uint64_t a = n, b = k, c = n - k; a > 0; a /= p, b /= p, c /= p)
+                if(a / p - b / p - c / p)
+                    power *= p;
+
+            if(power > 1)
+                factors.push_back(power);
+        }
+
+        return __product_of_units(factors);
+    }
+
+    vinteger primorial(std::uint64_t n)
+    {
+        const std::vector<std::uint32_t> primes = __prime_sieve(n);
+        return __product_of_units(std::vector<std::uint64_t>(primes.begin(), primes.end()));
+    }
+}
@@ -1,56 +1,49 @@
-#include "vinteger.h"
-
-namespace algae
-{
-    inline int __int_sign(const std::int64_t x) {
-        if(x > 0)
-            return 1;
-        
-        return x ? -1 : 0;
-    }
-
-    inline int __int_sign(const std::uint64_t x) {
-        return x ? 1 : 0;
-    }
-
-    inline std::int64_t __set_int_sign(const std::uint64_t x, int sign) {
-        return sign > 0 ? x : -((std::int64_t)x);
-    }
-
-    std::strong_ordering vinteger::__compare_template(const vinteger& a, const std::int64_t b)
-    {
-        if(auto r = a.sign() <=> __int_sign(b) ; r != std::strong_ordering::equal || (a.empty() && b == 0))
-            return r;
-
-        if(a.value_bit_width() >= __CUtype_bit_length - 1)
-            return std::strong_ordering::greater;
-
-        return __set_int_sign(a.__buffer[0], a.sign()) <=> b;
-    }
-
-    std::strong_ordering vinteger::__compare_template(const vinteger& a, const std::uint64_t b)
-    {
-        if(auto r = a.sign() <=> __int_sign(b); r != std::strong_ordering::equal || (a.empty() && b == 0)) 
-            return r;
-
-        if(a.value_bit_width() >= __CUtype_bit_length)
-            return std::strong_ordering::greater;
-
-        return a.__buffer[0] * a.sign() <=> b;
-    }
-
-
-    
-
-    std::strong_ordering operator <=>(const vinteger& a, const vinteger& b)
-    {
-        if(auto r = a.__bit_length <=> b.__bit_length; r != std::strong_ordering::equal || (a.empty() && b.empty()))
-            return r;
-
-        for(int i = a.__value_length() - 1; i >= 0; --i)
-            if(auto r = a.__buffer[i] <=> b.__buffer[i]; r != std::strong_ordering::equal)
-                return r;
-
-        return std::strong_ordering::equal;
-    }
+#include "vinteger_kernel.h"
+#include <limits>
+
+namespace algae
+{
+    std::strong_ordering vinteger::__compare_template(const vinteger& a, const std::int64_t b)
+    {
+        if(auto r = a.sign() <=> __int_sign(b) ; r != std::strong_ordering::equal || (a.empty() && b == 0))
+            return r;
+
+        // 超出 std::int64_t 的范围时只由符号决定，唯一的例外是 -2^63
+        if(a.value_bit_width() >= __CUtype_bit_length)
+        {
+            if(a.sign() < 0 && a.value_bit_width() == __CUtype_bit_length && a.__buffer[0] == (std::uint64_t(1) << 63))
+                return b == std::numeric_limits<std::int64_t>::min() ? std::strong_ordering::equal : std::strong_ordering::less;
+
+            return a.sign() > 0 ? std::strong_ordering::greater : std::strong_ordering::less;
+        }
+
+        return __set_int_sign(a.__buffer[0], a.sign()) <=> b;
+    }
+
+    std::strong_ordering vinteger::__compare_template(const vinteger& a, const std::uint64_t b)
+    {
+        if(auto r = a.sign() <=> __int_sign(b); r != std::strong_ordering::equal || (a.empty() && b == 0)) 
+            return r;
+
+        if(a.value_bit_width() > __CUtype_bit_length)
+            return std::strong_ordering::greater;
+
+        return a.__buffer[0] * a.sign() <=> b;
+    }
+
+
+    
+
+    std::strong_ordering operator <=>(const vinteger& a, const vinteger& b)
+    {
+        if(auto r = a.__bit_length <=> b.__bit_length; r != std::strong_ordering::equal || (a.empty() && b.empty()))
+            return r;
+
+        // 位宽相同时逐单元比较绝对值，负数的绝对值越大则值越小
+        for(std::int64_t i = std::int64_t(a.__value_length()) - 1; i >= 0; --i)
+            if(auto r = a.__buffer[i] <=> b.__buffer[i]; r != std::strong_ordering::equal)
+                return a.sign() > 0 ? r : 0 <=> r;
+
+        return std::strong_ordering::equal;
+    }
 }
\ No newline at end of file
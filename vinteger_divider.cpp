@@ -1,141 +1,526 @@
-#include "vinteger.h"
-#include <stdexcept>
-
-namespace algae
-{
-    extern std::int64_t __set_int_sign(const std::uint64_t x, int sign);
-
-    struct divider_context
-    {
-        using __CUtype = vinteger::__CUtype;
-        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
-
-        const vinteger *divisor = nullptr;
-        const vinteger *dividend = nullptr;
-
-        vinteger *merchant = nullptr, *remainder = nullptr;
-        int sign = 0;
-
-        bool pretreatment(const vinteger& x, const vinteger& y) 
-        {
-            if(x.empty())
-            {
-                if (merchant)
-                    merchant->clear();
-
-                if (remainder)
-                    remainder->clear();
-            }
-            else if(y.empty())
-                throw std::runtime_error("divisor is zero");
-            else if(y.value_bit_width() == 1)
-            {
-                if (merchant)
-                    *merchant = x.sign() == y.sign() ? x : -x;
-
-                if (remainder)
-                    remainder->clear();
-            }
-            else if(x.value_bit_width() > 64 || y.value_bit_width() > 64)
-                return false;
-            else
-            {
-                if (merchant)
-                {
-                    merchant->__change_capacity(1);
-                    merchant->__buffer[0] = x.__buffer[0] / y.__buffer[0];
-                    merchant->__bit_length = __set_int_sign(std::bit_width(merchant->__buffer[0]), sign);
-                }
-
-                if (remainder)
-                {
-                    remainder->__change_capacity(1);
-                    remainder->__buffer[0] = x.__buffer[0] % y.__buffer[0];
-                    remainder->__bit_length = __set_int_sign(std::bit_width(remainder->__buffer[0]), sign);
-                }
-            }
-
-            return true;
-        }
-
-        void naive_division()
-        {
-            if (this->divisor->value_bit_width() < this->dividend->value_bit_width())
-            {
-                if (remainder)
-                    *remainder = *this->divisor;
-                return;
-            }
-
-            vinteger divisor = *(this->divisor);
-            vinteger dividend = *(this->dividend) << (this->divisor->value_bit_width() - this->dividend->value_bit_width());
-             
-            for(int shift = this->divisor->value_bit_width() - this->dividend->value_bit_width(); shift >= 0; )
-            {
-                if(divisor < dividend)
-                {
-                    shift--, dividend >>= 1;
-                    continue;
-                }
-                
-                divisor -= dividend;
-                
-                if (merchant == nullptr)
-                    continue;
-
-                if(merchant->__capacity == 0)
-                    merchant->__change_capacity(std::max(std::size_t(shift / __CUtype_bit_length + bool(shift % __CUtype_bit_length)), std::size_t(1)), false, true);
-                
-                merchant->__buffer[shift / __CUtype_bit_length] |= 1ull << shift % __CUtype_bit_length;
-            }
-
-            if (merchant)
-                if(merchant->__capacity != 0)
-            {
-                auto bit_length = std::bit_width(merchant->__buffer[merchant->__capacity - 1]) + __CUtype_bit_length * (merchant->__capacity - 1);
-                merchant->__bit_length = __set_int_sign(bit_length, sign);
-            }
-
-            if (remainder)
-                *remainder = std::move(divisor);
-        }
-
-
-        divider_context(const vinteger& x, const vinteger& y, vinteger* z = nullptr, vinteger* w = nullptr)
-            :divisor(&x), dividend(&y), merchant(z), remainder(w), sign(x.sign() * y.sign())
-        {
-            if(pretreatment(x, y))
-                return;
-
-            naive_division();
-        }
-    };
-
-
-    vinteger operator/(const vinteger& a, const vinteger& b) 
-    {
-        vinteger merchant;
-        divider_context context(a, b, &merchant);
-        return merchant;
-    }
-
-    vinteger operator%(const vinteger& a, const vinteger& b)
-    {
-        vinteger remainder;
-        divider_context context(a, b, nullptr, &remainder);
-        return remainder;
-    }
-
-    vinteger& vinteger::operator/=(const vinteger& other)
-    {
-        *this = *this / other;
-        return *this;
-    }
-
-    vinteger& vinteger::operator%=(const vinteger& other)
-    {
-        *this = *this % other;
-        return *this;
-    }
-
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace algae
+{
+    struct divider_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        const vinteger *divisor = nullptr;
+        const vinteger *dividend = nullptr;
+
+        vinteger *merchant = nullptr, *remainder = nullptr;
+        int sign = 0;
+
+        bool pretreatment(const vinteger& x, const vinteger& y) 
+        {
+            if(x.empty())
+            {
+                if (merchant)
+                    merchant->clear();
+
+                if (remainder)
+                    remainder->clear();
+            }
+            else if(y.empty())
+                throw std::runtime_error("divisor is zero");
+            else if(y.value_bit_width() == 1)
+            {
+                if (merchant)
+                    *merchant = y.sign() > 0 ? x : -x;
+
+                if (remainder)
+                    remainder->clear();
+            }
+            else if(x.value_bit_width() > 64 || y.value_bit_width() > 64)
+                return false;
+            else
+            {
+                if (merchant)
+                {
+                    merchant->__change_capacity(1);
+                    merchant->__buffer[0] = x.__buffer[0] / y.__buffer[0];
+                    merchant->__bit_length = __set_int_sign(std::bit_width(merchant->__buffer[0]), sign);
+                }
+
+                if (remainder)
+                {
+                    remainder->__change_capacity(1);
+                    remainder->__buffer[0] = x.__buffer[0] % y.__buffer[0];
+                    remainder->__bit_length = __set_int_sign(std::bit_width(remainder->__buffer[0]), x.sign());
+                }
+            }
+
+            return true;
+        }
+
+        void naive_division()
+        {
+            if (this->divisor->value_bit_width() < this->dividend->value_bit_width())
+            {
+                if (remainder)
+                    *remainder = *this->divisor;
+                return;
+            }
+
+            vinteger divisor = *(this->divisor);
+            vinteger dividend = *(this->dividend) << (this->divisor->value_bit_width() - this->dividend->value_bit_width());
+             
+            for(std::int64_t shift = std::int64_t(this->divisor->value_bit_width()) - std::int64_t(this->dividend->value_bit_width()); shift >= 0; )
+            {
+                if(divisor < dividend)
+                {
+                    shift--, dividend >>= 1;
+                    continue;
+                }
+                
+                divisor -= dividend;
+                
+                if (merchant == nullptr)
+                    continue;
+
+                if(merchant->__capacity == 0)
+                    merchant->__change_capacity(shift / __CUtype_bit_length + 1, false, true);
+                
+                merchant->__buffer[shift / __CUtype_bit_length] |= 1ull << shift % __CUtype_bit_length;
+            }
+
+            if (merchant)
+                if(merchant->__capacity != 0)
+            {
+                auto bit_length = std::bit_width(merchant->__buffer[merchant->__capacity - 1]) + __CUtype_bit_length * (merchant->__capacity - 1);
+                merchant->__bit_length = __set_int_sign(bit_length, sign);
+            }
+
+            if (remainder)
+                *remainder = std::move(divisor);
+        }
+
+
+        // 比较两个非零整数的绝对值
+        static std::strong_ordering compare_magnitude(const vinteger& a, const vinteger& b)
+        {
+            if(auto r = a.value_bit_width() <=> b.value_bit_width(); r != 0)
+                return r;
+
+            for(std::size_t i = a.__value_length(); i-- > 0; )
+                if(a.__buffer[i] != b.__buffer[i])
+                    return a.__buffer[i] <=> b.__buffer[i];
+
+            return std::strong_ordering::equal;
+        }
+
+        // 除数只有一个计算单元：将除数规格化到最高位为 1，逐个计算单元试商
+        // u 长度为 m，商写入 q[0, m)，返回余数
+        static __CUtype unit_division(const __CUtype* u, const std::size_t m, __CUtype d, __CUtype* q)
+        {
+            const int shift = std::countl_zero(d);
+            d <<= shift;
+
+            __CUtype r = shift ? u[m - 1] >> (__CUtype_bit_length - shift) : 0;
+            for(std::size_t i = m; i-- > 0; )
+            {
+                const __CUtype low = u[i] << shift | (shift && i > 0 ? u[i - 1] >> (__CUtype_bit_length - shift) : 0);
+                q[i] = vinteger::__divide_unit(r, low, d, r);
+            }
+
+            return r >> shift;
+        }
+
+        // Knuth 4.3.1 算法 D：u 长度为 m，v 长度为 n（n >= 2，m >= n，最高计算单元非 0）
+        // 商写入 q[0, m - n]，余数写入 r[0, n)
+        // 规格化后以被除数的最高两个计算单元试商，再用除数的次高计算单元修正，试商至多偏大 1，由加回步骤纠正
+        static void knuth_division(const __CUtype* u, const std::size_t m, const __CUtype* v, const std::size_t n, __CUtype* q, __CUtype* r)
+        {
+            const int shift = std::countl_zero(v[n - 1]);
+            auto shifted = [shift](const __CUtype* x, const std::size_t i) {
+                return x[i] << shift | (shift && i > 0 ? x[i - 1] >> (__CUtype_bit_length - shift) : 0);
+            };
+
+            std::vector<__CUtype> vn(n), un(m + 1);
+            for(std::size_t i = 0; i < n; ++i)
+                vn[i] = shifted(v, i);
+
+            for(std::size_t i = 0; i < m; ++i)
+                un[i] = shifted(u, i);
+            un[m] = shift ? u[m - 1] >> (__CUtype_bit_length - shift) : 0;
+
+            const __CUtype top = vn[n - 1], second = vn[n - 2];
+
+            for(std::size_t j = m - n + 1; j-- > 0; )
+            {
+                __CUtype qhat, rhat;
+                bool rhat_overflow = false;
+
+                // 不变式保证 un[j + n] <= top，相等时试商取计算单元的最大值
+                if(un[j + n] >= top)
+                {
+                    qhat = ~__CUtype(0);
+                    rhat = un[j + n - 1] + top;
+                    rhat_overflow = rhat < top;
+                }
+                else
+                    qhat = vinteger::__divide_unit(un[j + n], un[j + n - 1], top, rhat);
+
+                while(!rhat_overflow)
+                {
+                    __CUtype high;
+                    const __CUtype low = vinteger::__multiply_unit(qhat, second, high);
+                    if(high < rhat || (high == rhat && low <= un[j + n - 2]))
+                        break;
+
+                    --qhat, rhat += top;
+                    rhat_overflow = rhat < top;
+                }
+
+                // un[j, j + n] -= qhat * vn
+                __CUtype carry = 0, retreat = 0;
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    __CUtype high;
+                    __CUtype low = vinteger::__multiply_unit(qhat, vn[i], high);
+                    low += carry, high += low < carry;
+                    carry = high;
+
+                    const __CUtype diff = un[i + j] - low - retreat;
+                    retreat = un[i + j] < low || (un[i + j] == low && retreat);
+                    un[i + j] = diff;
+                }
+
+                const __CUtype diff = un[j + n] - carry - retreat;
+                const bool negative = un[j + n] < carry || (un[j + n] == carry && retreat);
+                un[j + n] = diff;
+
+                // 试商偏大 1，加回一次除数
+                if(negative)
+                {
+                    --qhat;
+                    bool carry_back = false;
+                    for(std::size_t i = 0; i < n; ++i)
+                    {
+                        const __CUtype sum = un[i + j] + vn[i] + carry_back;
+                        carry_back = sum < un[i + j] || (sum == un[i + j] && carry_back);
+                        un[i + j] = sum;
+                    }
+                    un[j + n] += carry_back;
+                }
+
+                q[j] = qhat;
+            }
+
+            for(std::size_t i = 0; i < n; ++i)
+                r[i] = un[i] >> shift | (shift ? un[i + 1] << (__CUtype_bit_length - shift) : 0);
+        }
+
+        // 多计算单元的带余除法，商向零取整，余数与被除数同号
+        void limb_division(const vinteger& x, const vinteger& y)
+        {
+            const std::size_t m = x.__value_length(), n = y.__value_length();
+
+            vinteger q, r;
+            q.__change_capacity(m - n + 1, false, true);
+            r.__change_capacity(n, false, true);
+
+            if(n == 1)
+                r.__buffer[0] = unit_division(x.__buffer, m, y.__buffer[0], q.__buffer);
+            else
+                knuth_division(x.__buffer, m, y.__buffer, n, q.__buffer, r.__buffer);
+
+            q.__refresh_bit_length(m - n + 1, sign);
+            r.__refresh_bit_length(n, x.sign());
+
+            if (merchant)
+                *merchant = std::move(q);
+
+            if (remainder)
+                *remainder = std::move(r);
+        }
+
+
+        // 奇数 d 在模 2^64 下的逆元：查表得到低 8 位，再做三次 Newton 迭代 x = x * (2 - d * x)，每次精度加倍
+        static __CUtype unit_inverse(const __CUtype d)
+        {
+            // 奇数 2i + 1 在模 2^8 下的逆元；d * d ≡ 1 (mod 8)，从 3 位开始迭代两次即可
+            constexpr static auto table = [] {
+                std::array<std::uint8_t, 128> result{};
+                for(unsigned i = 0; i < 128; ++i)
+                {
+                    const unsigned odd = 2 * i + 1;
+                    unsigned x = odd;
+                    for(int k = 0; k < 2; ++k)
+                        x *= 2 - odd * x;
+
+                    result[i] = std::uint8_t(x);
+                }
+
+                return result;
+            }();
+
+            __CUtype x = table[(d >> 1) & 127];
+            for(int k = 0; k < 3; ++k)
+                x *= 2 - d * x;
+
+            return x;
+        }
+
+        // 除数只有一个计算单元的 Hensel 整除，d 为奇数，inverse 为 d 的逆元，u 长度为 m，商写入 q[0, m)
+        // q[i] = (u[i] - borrow) * inverse，borrow 为 q[i] * d 的高位加上这次减法的借位
+        static void unit_exact_division(const __CUtype* u, const std::size_t m, const __CUtype d, const __CUtype inverse, __CUtype* q)
+        {
+            __CUtype borrow = 0;
+            for(std::size_t i = 0; i < m; ++i)
+            {
+                const __CUtype x = u[i] - borrow;
+                const bool under = u[i] < borrow;
+                q[i] = x * inverse;
+
+                __CUtype high;
+                vinteger::__multiply_unit(q[i], d, high);
+                borrow = high + under;
+            }
+        }
+
+        // 多计算单元的 Hensel 整除，v 长度为 n 且 v[0] 为奇数，inverse 为 v[0] 的逆元
+        // 商恰好由 u 的低 qn 个计算单元决定：q[i] = u[i] * inverse，再从 u[i, qn) 中减去 q[i] * v，u 被改写
+        static void hensel_division(__CUtype* u, const std::size_t qn, const __CUtype* v, const std::size_t n, const __CUtype inverse, __CUtype* q)
+        {
+            for(std::size_t i = 0; i < qn; ++i)
+            {
+                const __CUtype qi = u[i] * inverse;
+                q[i] = qi;
+
+                // 高于 qn 的部分不影响商，不必计算
+                const std::size_t length = std::min(n, qn - i);
+                __CUtype carry = 0;
+                bool retreat = false;
+                for(std::size_t j = 0; j < length; ++j)
+                {
+                    __CUtype high;
+                    __CUtype low = vinteger::__multiply_unit(qi, v[j], high);
+                    low += carry, high += low < carry;
+                    carry = high;
+                    u[i + j] = full_subtractor(u[i + j], low, retreat);
+                }
+
+                for(std::size_t j = i + length; j < qn && (carry || retreat); ++j, carry = 0)
+                    u[j] = full_subtractor(u[j], carry, retreat);
+            }
+        }
+
+        static vinteger exact_division(const vinteger& a, const vinteger& b)
+        {
+            if(b.empty())
+                throw std::runtime_error("divisor is zero");
+
+            if(a.empty())
+                return a;
+
+            ALGAE_VINTEGER_INSTRUMENT(divide, a.__value_length() + b.__value_length());
+            ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(vinteger_algorithm::exact_division);
+
+            // 除数末尾的 0 位在被除数中也是 0，两者同时右移，使除数的最低计算单元为奇数
+            std::size_t zeros = 0;
+            while(b.__buffer[zeros / __CUtype_bit_length] == 0)
+                zeros += __CUtype_bit_length;
+            zeros += std::countr_zero(b.__buffer[zeros / __CUtype_bit_length]);
+
+            vinteger shifted_a, shifted_b;
+            const vinteger* x = &a;
+            const vinteger* y = &b;
+            if(zeros)
+            {
+                shifted_a = a >> zeros, shifted_b = b >> zeros;
+                x = &shifted_a, y = &shifted_b;
+            }
+
+            const std::size_t m = x->__value_length(), n = y->__value_length();
+            vinteger q;
+            if(m < n)
+                return q;
+
+            const std::size_t qn = m - n + 1;
+            q.__change_capacity(qn);
+
+            const __CUtype inverse = unit_inverse(y->__buffer[0]);
+            if(n == 1)
+                unit_exact_division(x->__buffer, m, y->__buffer[0], inverse, q.__buffer);
+            else
+            {
+                std::vector<__CUtype> u(x->__buffer, x->__buffer + qn);
+                hensel_division(u.data(), qn, y->__buffer, n, inverse, q.__buffer);
+            }
+
+            q.__refresh_bit_length(qn, a.sign() * b.sign());
+            return q;
+        }
+
+
+        // |x| 的低 k 位
+        static vinteger low_bits(const vinteger& x, const std::size_t k)
+        {
+            const std::size_t units = std::min(x.__value_length(), k / __CUtype_bit_length + bool(k % __CUtype_bit_length));
+
+            vinteger result;
+            if(units == 0)
+                return result;
+
+            result.__change_capacity(units);
+            std::copy(x.__buffer, x.__buffer + units, result.__buffer);
+            if(units > k / __CUtype_bit_length)
+                result.__buffer[units - 1] &= (__CUtype(1) << k % __CUtype_bit_length) - 1;
+
+            result.__refresh_bit_length(units);
+            return result;
+        }
+
+        // |x| 的低 k 位中是否有 1
+        static bool has_low_bits(const vinteger& x, const std::size_t k)
+        {
+            const std::size_t length = x.__value_length(), whole = std::min(length, k / __CUtype_bit_length);
+            for(std::size_t i = 0; i < whole; ++i)
+                if(x.__buffer[i])
+                    return true;
+
+            return whole < length && k % __CUtype_bit_length && (x.__buffer[whole] & ((__CUtype(1) << k % __CUtype_bit_length) - 1));
+        }
+
+
+        divider_context() = default;
+
+        divider_context(const vinteger& x, const vinteger& y, vinteger* z = nullptr, vinteger* w = nullptr)
+            :divisor(&x), dividend(&y), merchant(z), remainder(w), sign(x.sign() * y.sign())
+        {
+            ALGAE_VINTEGER_INSTRUMENT(divide, x.__value_length() + y.__value_length());
+            ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(y.__value_length() == 1 ? vinteger_algorithm::unit_division : vinteger_algorithm::knuth_division);
+
+            if(pretreatment(x, y))
+                return;
+
+            if(compare_magnitude(x, y) < 0)
+            {
+                // 须先写余数：商与被除数可能是同一个对象
+                if (remainder)
+                    *remainder = x;
+
+                if (merchant)
+                    merchant->clear();
+
+                return;
+            }
+
+            limb_division(x, y);
+        }
+    };
+
+
+    vinteger operator/(const vinteger& a, const vinteger& b) 
+    {
+        vinteger merchant;
+        divider_context context(a, b, &merchant);
+        return merchant;
+    }
+
+    vinteger operator%(const vinteger& a, const vinteger& b)
+    {
+        vinteger remainder;
+        divider_context context(a, b, nullptr, &remainder);
+        return remainder;
+    }
+
+    // 同时求商与余数，只做一次除法
+    void __divmod(const vinteger& a, const vinteger& b, vinteger& quotient, vinteger& remainder) {
+        divider_context context(a, b, &quotient, &remainder);
+    }
+
+    std::pair<vinteger, vinteger> divmod(const vinteger& a, const vinteger& b)
+    {
+        std::pair<vinteger, vinteger> result;
+        divider_context context(a, b, &result.first, &result.second);
+        return result;
+    }
+
+    vinteger tdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder)
+    {
+        auto [q, r] = divmod(a, b);
+        remainder = std::move(r);
+        return q;
+    }
+
+    // 截断除法的余数不为 0 且与除数异号时，商减 1、余数加上除数
+    vinteger fdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder)
+    {
+        auto [q, r] = divmod(a, b);
+        if(!r.empty() && r.sign() != b.sign())
+            q -= 1, r += b;
+
+        remainder = std::move(r);
+        return q;
+    }
+
+    // 截断除法的余数不为 0 且与除数同号时，商加 1、余数减去除数
+    vinteger cdiv_qr(const vinteger& a, const vinteger& b, vinteger& remainder)
+    {
+        auto [q, r] = divmod(a, b);
+        if(!r.empty() && r.sign() == b.sign())
+            q += 1, r -= b;
+
+        remainder = std::move(r);
+        return q;
+    }
+
+    // 移位向零取整，负数移出的位中有 1 时再减 1
+    vinteger div_2exp(const vinteger& a, const std::size_t k)
+    {
+        vinteger q = a >> k;
+        if(a.sign() < 0 && divider_context::has_low_bits(a, k))
+            q -= 1;
+
+        return q;
+    }
+
+    vinteger mod_2exp(const vinteger& a, const std::size_t k)
+    {
+        vinteger r = divider_context::low_bits(a, k);
+        if(a.sign() < 0 && !r.empty())
+            r = (vinteger(1) << k) - r;
+
+        return r;
+    }
+
+    vinteger divexact(const vinteger& a, const vinteger& b) {
+        return divider_context::exact_division(a, b);
+    }
+
+    // 逐位试减的基准实现，仅供测试对拍使用，a 与 b 须为正
+    vinteger __naive_divide(const vinteger& a, const vinteger& b)
+    {
+        vinteger merchant;
+        divider_context context;
+        if(b.empty())
+            throw std::runtime_error("divisor is zero");
+
+        context.divisor = &a, context.dividend = &b;
+        context.merchant = &merchant;
+        context.sign = a.sign() * b.sign();
+        context.naive_division();
+        return merchant;
+    }
+
+    vinteger& vinteger::operator/=(const vinteger& other)
+    {
+        *this = *this / other;
+        return *this;
+    }
+
+    vinteger& vinteger::operator%=(const vinteger& other)
+    {
+        *this = *this % other;
+        return *this;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef ALGAE_VINTEGER_EXECUTION_H
+#define ALGAE_VINTEGER_EXECUTION_H
+
+// 标准执行策略的适配层
+// <execution> 在部分标准库实现中依赖 TBB 等外部库，因此不由 vinteger.h 引入，需要时单独包含本文件
+#include <execution>
+#include "vinteger.h"
+
+namespace algae
+{
+    template<class P>
+    concept __execution_policy = std::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+    // 并行策略使用全部硬件线程，顺序与向量化策略只使用调用线程
+    template<__execution_policy P>
+    constexpr exec_policy __to_exec_policy(const P&)
+    {
+        using policy = std::remove_cvref_t<P>;
+        if constexpr(std::same_as<policy, std::execution::parallel_policy> || std::same_as<policy, std::execution::parallel_unsequenced_policy>)
+            return exec_policy{0};
+        else
+            return exec_policy{1};
+    }
+
+    template<__execution_policy P, __vinteger_range R>
+    vinteger sum(P&& policy, R&& range) {
+        return sum(std::forward<R>(range), __to_exec_policy(policy));
+    }
+
+    template<__execution_policy P, __vinteger_range R>
+    vinteger product(P&& policy, R&& range) {
+        return product(std::forward<R>(range), __to_exec_policy(policy));
+    }
+
+    template<__execution_policy P, __vinteger_range A, __vinteger_range B>
+    vinteger dot(P&& policy, A&& a, B&& b) {
+        return dot(std::forward<A>(a), std::forward<B>(b), __to_exec_policy(policy));
+    }
+
+    template<__execution_policy P>
+    vinteger mul(P&& policy, const vinteger& a, const vinteger& b) {
+        return mul(a, b, __to_exec_policy(policy));
+    }
+}
+
+#endif
@@ -0,0 +1,588 @@
+#ifndef ALGAE_VINTEGER_FIXED_INT_H
+#define ALGAE_VINTEGER_FIXED_INT_H
+
+// 定长整数 fixed_int<Bits, Signed>
+// 计算单元保存在 std::array 中，不分配内存也不检查长度；所有运算都是 constexpr，按位宽回绕（模 2^Bits）
+// 有符号类型使用二进制补码，除法向零取整，余数与被除数同号，与 vinteger 一致
+#include <array>
+#include <stdexcept>
+#include "vinteger.h"
+
+namespace algae
+{
+    template<std::size_t Bits, bool Signed = false>
+    class fixed_int
+    {
+        static_assert(Bits > 0 && Bits % 64 == 0, "fixed_int width must be a positive multiple of 64 bits");
+
+    public:
+        using limb_type = std::uint64_t;
+        constexpr static std::size_t limb_bit_length = 64;
+        constexpr static std::size_t limb_count = Bits / limb_bit_length;
+        constexpr static std::size_t bit_count = Bits;
+        constexpr static bool is_signed = Signed;
+
+        // 低位在前的计算单元，有符号时为二进制补码
+        std::array<limb_type, limb_count> limbs{};
+
+    private:
+        template<std::size_t, bool> friend class fixed_int;
+
+        // 对 0..N-1 逐个调用 f，以折叠表达式在编译期完全展开
+        template<std::size_t N, class F>
+        constexpr static void __unroll(F&& f)
+        {
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (f(std::integral_constant<std::size_t, I>{}), ...);
+            }(std::make_index_sequence<N>{});
+        }
+
+        // 64 位乘法，返回低 64 位，高 64 位写入 high
+        constexpr static limb_type __multiply_unit(const limb_type a, const limb_type b, limb_type& high)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 product = (unsigned __int128)a * b;
+            high = limb_type(product >> 64);
+            return limb_type(product);
+#else
+            const limb_type a0 = a & 0xffffffff, a1 = a >> 32, b0 = b & 0xffffffff, b1 = b >> 32;
+            const limb_type p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+            const limb_type middle = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+            high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+            return (middle << 32) | (p00 & 0xffffffff);
+#endif
+        }
+
+        // (high, low) / divisor，要求 high < divisor，余数写入 remainder
+        constexpr static limb_type __divide_unit(const limb_type high, const limb_type low, const limb_type divisor, limb_type& remainder)
+        {
+#if defined(__SIZEOF_INT128__)
+            const unsigned __int128 dividend = ((unsigned __int128)high << 64) | low;
+            remainder = limb_type(dividend % divisor);
+            return limb_type(dividend / divisor);
+#else
+            // 逐位试减，r 的最高位移出时必然可以减去除数
+            limb_type r = high, q = 0;
+            for(int i = 63; i >= 0; --i)
+            {
+                const bool overflow = r >> 63;
+                r = (r << 1) | (low >> i & 1);
+                q <<= 1;
+                if(overflow || r >= divisor)
+                    r -= divisor, q |= 1;
+            }
+
+            remainder = r;
+            return q;
+#endif
+        }
+
+        constexpr bool __negative() const {
+            return Signed && (limbs[limb_count - 1] >> (limb_bit_length - 1));
+        }
+
+        constexpr static fixed_int __negate(fixed_int x)
+        {
+            bool carry = true;
+            __unroll<limb_count>([&](auto i)
+            {
+                x.limbs[i] = ~x.limbs[i] + carry;
+                carry = carry && x.limbs[i] == 0;
+            });
+
+            return x;
+        }
+
+        constexpr fixed_int __magnitude() const {
+            return __negative() ? __negate(*this) : *this;
+        }
+
+        // 无符号比较
+        constexpr static std::strong_ordering __compare_unsigned(const fixed_int& a, const fixed_int& b)
+        {
+            for(std::size_t i = limb_count; i-- > 0; )
+                if(a.limbs[i] != b.limbs[i])
+                    return a.limbs[i] <=> b.limbs[i];
+
+            return std::strong_ordering::equal;
+        }
+
+        // 最高非零计算单元的个数
+        constexpr static std::size_t __significant(const std::array<limb_type, limb_count>& x)
+        {
+            std::size_t n = limb_count;
+            while(n > 0 && x[n - 1] == 0)
+                --n;
+
+            return n;
+        }
+
+        // 无符号除法：单计算单元的除数逐单元相除，否则使用 Knuth 算法 D
+        constexpr static void __divide_unsigned(const fixed_int& u, const fixed_int& v, fixed_int& q, fixed_int& r)
+        {
+            q = fixed_int(), r = fixed_int();
+
+            const std::size_t n = __significant(v.limbs), m = __significant(u.limbs);
+            if(n == 0)
+                throw std::runtime_error("divisor is zero");
+
+            if(__compare_unsigned(u, v) < 0)
+            {
+                r = u;
+                return;
+            }
+
+            if(n == 1)
+            {
+                limb_type rem = 0;
+                for(std::size_t i = m; i-- > 0; )
+                    q.limbs[i] = __divide_unit(rem, u.limbs[i], v.limbs[0], rem);
+
+                r.limbs[0] = rem;
+                return;
+            }
+
+            // 规格化：除数最高位为 1
+            const int s = std::countl_zero(v.limbs[n - 1]);
+            std::array<limb_type, limb_count> vn{};
+            std::array<limb_type, limb_count + 1> un{};
+
+            for(std::size_t i = n; i-- > 0; )
+                vn[i] = (v.limbs[i] << s) | (s && i ? v.limbs[i - 1] >> (64 - s) : 0);
+
+            un[m] = s ? u.limbs[m - 1] >> (64 - s) : 0;
+            for(std::size_t i = m; i-- > 0; )
+                un[i] = (u.limbs[i] << s) | (s && i ? u.limbs[i - 1] >> (64 - s) : 0);
+
+            for(std::size_t j = m - n + 1; j-- > 0; )
+            {
+                // 以最高两个单元估计商，估计值至多偏大 2
+                limb_type qhat, rhat;
+                bool rhat_overflow = false;
+                if(un[j + n] >= vn[n - 1])
+                {
+                    qhat = ~limb_type(0);
+                    rhat = un[j + n - 1] + vn[n - 1];
+                    rhat_overflow = rhat < vn[n - 1];
+                }
+                else
+                    qhat = __divide_unit(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+
+                while(!rhat_overflow)
+                {
+                    limb_type high;
+                    const limb_type low = __multiply_unit(qhat, vn[n - 2], high);
+                    if(high < rhat || (high == rhat && low <= un[j + n - 2]))
+                        break;
+
+                    --qhat;
+                    rhat += vn[n - 1];
+                    rhat_overflow = rhat < vn[n - 1];
+                }
+
+                // un[j .. j + n] -= qhat * vn
+                limb_type carry = 0, borrow = 0;
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    limb_type high;
+                    limb_type low = __multiply_unit(qhat, vn[i], high);
+                    low += carry;
+                    high += low < carry;
+                    carry = high;
+
+                    const limb_type t = un[i + j] - low - borrow;
+                    borrow = (un[i + j] < low) || (un[i + j] - low < borrow);
+                    un[i + j] = t;
+                }
+
+                const limb_type t = un[j + n] - carry - borrow;
+                borrow = (un[j + n] < carry) || (un[j + n] - carry < borrow);
+                un[j + n] = t;
+
+                // 估计值偏大 1 时加回一次除数
+                if(borrow)
+                {
+                    --qhat;
+                    bool c = false;
+                    for(std::size_t i = 0; i < n; ++i)
+                    {
+                        const limb_type sum = un[i + j] + vn[i];
+                        const bool overflow = sum < un[i + j];
+                        un[i + j] = sum + c;
+                        c = overflow || un[i + j] < sum;
+                    }
+
+                    un[j + n] += c;
+                }
+
+                q.limbs[j] = qhat;
+            }
+
+            for(std::size_t i = 0; i < n; ++i)
+                r.limbs[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+        }
+
+        // 有符号除法向零取整，余数与被除数同号
+        constexpr static void __divide(const fixed_int& a, const fixed_int& b, fixed_int& q, fixed_int& r)
+        {
+            __divide_unsigned(a.__magnitude(), b.__magnitude(), q, r);
+
+            if(a.__negative() != b.__negative())
+                q = __negate(q);
+
+            if(a.__negative())
+                r = __negate(r);
+        }
+
+    public:
+        constexpr fixed_int() = default;
+
+        // 按位宽回绕，负数符号扩展
+        template<std::integral T>
+        constexpr fixed_int(const T x)
+        {
+            limbs[0] = limb_type(x);
+            if constexpr(std::is_signed_v<T>)
+                for(std::size_t i = 1; i < limb_count; ++i)
+                    limbs[i] = x < 0 ? ~limb_type(0) : 0;
+        }
+
+        // 不同位宽之间的转换，截断高位或按符号扩展
+        template<std::size_t OtherBits, bool OtherSigned>
+        constexpr explicit fixed_int(const fixed_int<OtherBits, OtherSigned>& x)
+        {
+            const limb_type extension = x.__negative() ? ~limb_type(0) : 0;
+            for(std::size_t i = 0; i < limb_count; ++i)
+                limbs[i] = i < x.limb_count ? x.limbs[i] : extension;
+        }
+
+        // 解析十进制字符串，可带负号，超出位宽时回绕
+        constexpr explicit fixed_int(const std::string_view source)
+        {
+            const bool negative = !source.empty() && source[0] == '-';
+            const std::string_view digits = source.substr(negative);
+            if(digits.empty())
+                throw std::invalid_argument("source is not a valid integer");
+
+            for(const char c : digits)
+            {
+                if(c < '0' || c > '9')
+                    throw std::invalid_argument("source is not a valid integer");
+
+                *this = *this * fixed_int(10) + fixed_int(c - '0');
+            }
+
+            if(negative)
+                *this = __negate(*this);
+        }
+
+        // 从 vinteger 转换，超出位宽时回绕（取模 2^Bits）
+        explicit fixed_int(const vinteger& x)
+        {
+            const std::span<const std::uint64_t> source = vinteger_view(x).limbs();
+            for(std::size_t i = 0; i < limb_count && i < source.size(); ++i)
+                limbs[i] = source[i];
+
+            if(x.sign() < 0)
+                *this = __negate(*this);
+        }
+
+        explicit operator vinteger() const
+        {
+            const fixed_int magnitude = __magnitude();
+            const vinteger result = import_bits(magnitude.limbs.data(), limb_count, sizeof(limb_type));
+            return __negative() ? -result : result;
+        }
+
+        template<std::integral T>
+        constexpr explicit operator T() const {
+            return T(limbs[0]);
+        }
+
+        constexpr explicit operator bool() const {
+            return !empty();
+        }
+
+        constexpr int sign() const {
+            return __negative() ? -1 : empty() ? 0 : 1;
+        }
+
+        constexpr bool empty() const
+        {
+            for(const limb_type limb : limbs)
+                if(limb)
+                    return false;
+
+            return true;
+        }
+
+        // 绝对值的二进制位宽
+        constexpr std::size_t value_bit_width() const
+        {
+            const fixed_int magnitude = __magnitude();
+            const std::size_t n = __significant(magnitude.limbs);
+            return n ? (n - 1) * limb_bit_length + std::bit_width(magnitude.limbs[n - 1]) : 0;
+        }
+
+        constexpr std::string to_string() const
+        {
+            if(empty())
+                return "0";
+
+            // 每次除以 10^19，逐段生成十进制数字
+            constexpr limb_type chunk = 10000000000000000000ull;
+            fixed_int x = __magnitude();
+            std::string result;
+
+            while(!x.empty())
+            {
+                limb_type rem = 0;
+                for(std::size_t i = limb_count; i-- > 0; )
+                    x.limbs[i] = __divide_unit(rem, x.limbs[i], chunk, rem);
+
+                for(int i = 0; i < 19 && (rem || !x.empty()); ++i)
+                    result.push_back(char('0' + rem % 10)), rem /= 10;
+            }
+
+            if(__negative())
+                result.push_back('-');
+
+            return std::string(result.rbegin(), result.rend());
+        }
+
+        explicit operator std::string() const {
+            return to_string();
+        }
+
+
+
+        // ****** cmp operations ******
+        friend constexpr bool operator==(const fixed_int& a, const fixed_int& b) = default;
+
+        friend constexpr std::strong_ordering operator<=>(const fixed_int& a, const fixed_int& b)
+        {
+            if(a.__negative() != b.__negative())
+                return a.__negative() ? std::strong_ordering::less : std::strong_ordering::greater;
+
+            // 同号时补码的无符号比较与数值比较一致
+            return __compare_unsigned(a, b);
+        }
+
+
+
+        // ****** arithmetic operations ******
+        constexpr fixed_int operator-() const {
+            return __negate(*this);
+        }
+
+        constexpr fixed_int operator+() const {
+            return *this;
+        }
+
+        friend constexpr fixed_int operator+(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            bool carry = false;
+            __unroll<limb_count>([&](auto i)
+            {
+                const limb_type sum = a.limbs[i] + b.limbs[i];
+                const bool overflow = sum < a.limbs[i];
+                r.limbs[i] = sum + carry;
+                carry = overflow || r.limbs[i] < sum;
+            });
+
+            return r;
+        }
+
+        friend constexpr fixed_int operator-(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            bool borrow = false;
+            __unroll<limb_count>([&](auto i)
+            {
+                const limb_type difference = a.limbs[i] - b.limbs[i];
+                const bool underflow = a.limbs[i] < b.limbs[i];
+                r.limbs[i] = difference - borrow;
+                borrow = underflow || difference < limb_type(borrow);
+            });
+
+            return r;
+        }
+
+        // 只计算落在位宽之内的部分积，补码乘法的低位与无符号乘法相同
+        friend constexpr fixed_int operator*(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            __unroll<limb_count>([&](auto i)
+            {
+                limb_type carry = 0;
+                __unroll<limb_count - i>([&](auto j)
+                {
+                    limb_type high;
+                    limb_type low = __multiply_unit(a.limbs[i], b.limbs[j], high);
+                    low += carry;
+                    high += low < carry;
+                    r.limbs[i + j] += low;
+                    high += r.limbs[i + j] < low;
+                    carry = high;
+                });
+            });
+
+            return r;
+        }
+
+        friend constexpr fixed_int operator/(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int q, r;
+            __divide(a, b, q, r);
+            return q;
+        }
+
+        friend constexpr fixed_int operator%(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int q, r;
+            __divide(a, b, q, r);
+            return r;
+        }
+
+        constexpr fixed_int& operator+=(const fixed_int& b) {
+            return *this = *this + b;
+        }
+
+        constexpr fixed_int& operator-=(const fixed_int& b) {
+            return *this = *this - b;
+        }
+
+        constexpr fixed_int& operator*=(const fixed_int& b) {
+            return *this = *this * b;
+        }
+
+        constexpr fixed_int& operator/=(const fixed_int& b) {
+            return *this = *this / b;
+        }
+
+        constexpr fixed_int& operator%=(const fixed_int& b) {
+            return *this = *this % b;
+        }
+
+        constexpr fixed_int& operator++() {
+            return *this += fixed_int(1);
+        }
+
+        constexpr fixed_int& operator--() {
+            return *this -= fixed_int(1);
+        }
+
+        constexpr fixed_int operator++(int)
+        {
+            const fixed_int old = *this;
+            ++*this;
+            return old;
+        }
+
+        constexpr fixed_int operator--(int)
+        {
+            const fixed_int old = *this;
+            --*this;
+            return old;
+        }
+
+
+
+        // ****** bit operations ******
+        constexpr fixed_int operator~() const
+        {
+            fixed_int r;
+            __unroll<limb_count>([&](auto i) { r.limbs[i] = ~limbs[i]; });
+            return r;
+        }
+
+        friend constexpr fixed_int operator&(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            __unroll<limb_count>([&](auto i) { r.limbs[i] = a.limbs[i] & b.limbs[i]; });
+            return r;
+        }
+
+        friend constexpr fixed_int operator|(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            __unroll<limb_count>([&](auto i) { r.limbs[i] = a.limbs[i] | b.limbs[i]; });
+            return r;
+        }
+
+        friend constexpr fixed_int operator^(const fixed_int& a, const fixed_int& b)
+        {
+            fixed_int r;
+            __unroll<limb_count>([&](auto i) { r.limbs[i] = a.limbs[i] ^ b.limbs[i]; });
+            return r;
+        }
+
+        constexpr fixed_int operator<<(const std::size_t shift) const
+        {
+            fixed_int r;
+            if(shift >= Bits)
+                return r;
+
+            const std::size_t unit = shift / limb_bit_length, bit = shift % limb_bit_length;
+            for(std::size_t i = limb_count; i-- > unit; )
+                r.limbs[i] = (limbs[i - unit] << bit) | (bit && i > unit ? limbs[i - unit - 1] >> (limb_bit_length - bit) : 0);
+
+            return r;
+        }
+
+        // 有符号类型为算术右移
+        constexpr fixed_int operator>>(const std::size_t shift) const
+        {
+            const limb_type extension = __negative() ? ~limb_type(0) : 0;
+            fixed_int r;
+            r.limbs.fill(extension);
+            if(shift >= Bits)
+                return r;
+
+            const std::size_t unit = shift / limb_bit_length, bit = shift % limb_bit_length;
+            for(std::size_t i = 0; i + unit < limb_count; ++i)
+            {
+                const limb_type next = i + unit + 1 < limb_count ? limbs[i + unit + 1] : extension;
+                r.limbs[i] = (limbs[i + unit] >> bit) | (bit ? next << (limb_bit_length - bit) : 0);
+            }
+
+            return r;
+        }
+
+        constexpr fixed_int& operator&=(const fixed_int& b) {
+            return *this = *this & b;
+        }
+
+        constexpr fixed_int& operator|=(const fixed_int& b) {
+            return *this = *this | b;
+        }
+
+        constexpr fixed_int& operator^=(const fixed_int& b) {
+            return *this = *this ^ b;
+        }
+
+        constexpr fixed_int& operator<<=(const std::size_t shift) {
+            return *this = *this << shift;
+        }
+
+        constexpr fixed_int& operator>>=(const std::size_t shift) {
+            return *this = *this >> shift;
+        }
+
+        friend std::ostream& operator<<(std::ostream& out, const fixed_int& x) {
+            return out << x.to_string();
+        }
+    };
+
+    using uint128 = fixed_int<128>;
+    using uint256 = fixed_int<256>;
+    using uint512 = fixed_int<512>;
+    using uint1024 = fixed_int<1024>;
+    using int128 = fixed_int<128, true>;
+    using int256 = fixed_int<256, true>;
+    using int512 = fixed_int<512, true>;
+    using int1024 = fixed_int<1024, true>;
+}
+
+#endif
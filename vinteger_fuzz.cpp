@@ -0,0 +1,602 @@
+// vinteger 差分模糊测试
+// 把快速路径（加减、Karatsuba 乘法、Knuth 除法与 Hensel 整除、累加器、十进制转换、half-GCD）与简单的参考实现对拍：
+//   乘法与除法以 __naive_multiply / __naive_divide 为基准，加减、比较与移位以逐计算单元的参考实现为基准，
+//   更大的规模上检查代数恒等式（a = q * b + r、乘法交换律与分配律、字符串往返、Bezout 等式），
+//   定长的 fixed_int<128/256> 以回绕到相同位宽的 vinteger 结果为基准
+// 操作数长度取在各个算法阈值附近，形状包括全 1（进位传播）、2 的幂、2^k - 1 与最高计算单元只有一位等边界情形
+//
+// 用 libFuzzer 构建时（CMake 选项 VINTEGER_LIBFUZZER）导出 LLVMFuzzerTestOneInput；
+// 否则编译为独立的随机驱动程序：
+//   vinteger_fuzz [--iterations N] [--seed S] [--max-limbs M] [--huge K]
+// --huge 另外运行 K 组超过 2^32 位的移位、乘法、位宽与比较检查，每组约需 2 GiB 内存
+#include "vinteger.h"
+#include "vinteger_fixed_int.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace algae
+{
+    // 定义于 vinteger_multiplier.cpp
+    extern vinteger __naive_multiply(const vinteger& a, const vinteger& b);
+    // 定义于 vinteger_divider.cpp
+    extern vinteger __naive_divide(const vinteger& a, const vinteger& b);
+}
+
+namespace
+{
+    using namespace algae;
+    using limbs = std::vector<std::uint64_t>;
+
+    // 随机驱动时的操作数长度上限；libFuzzer 模式下保持较小以维持吞吐量
+    std::size_t max_limbs = 160;
+    // 参考乘法与参考除法的规模上限（计算单元数），二者按位迭代，代价较高
+    constexpr std::size_t naive_limbs = 48;
+
+    struct fuzz_input
+    {
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t position = 0;
+
+        bool more() const {
+            return position < size;
+        }
+
+        // 数据用完后返回 0，使任意长度的输入都能完整解码
+        std::uint8_t byte() {
+            return position < size ? data[position++] : 0;
+        }
+
+        std::uint64_t word()
+        {
+            std::uint64_t x = 0;
+            for(int i = 0; i < 8; ++i)
+                x |= std::uint64_t(byte()) << (8 * i);
+
+            return x;
+        }
+
+        std::size_t below(const std::size_t n) {
+            return n ? std::size_t(byte() | std::size_t(byte()) << 8) % n : 0;
+        }
+
+        // 以一个输入字为种子生成的伪随机计算单元序列（splitmix64），长操作数不必消耗同样长的输入
+        static std::uint64_t next(std::uint64_t& state)
+        {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+    };
+
+
+
+    // ****** 参考实现：非负的计算单元数组，低位在前，不含高位的 0 ******
+    void trim(limbs& x)
+    {
+        while(!x.empty() && x.back() == 0)
+            x.pop_back();
+    }
+
+    limbs magnitude(const vinteger& x)
+    {
+        const std::span<const std::uint64_t> units = vinteger_view(x).limbs();
+        return limbs(units.begin(), units.end());
+    }
+
+    vinteger make(const limbs& x, const int sign = 1) {
+        return vinteger_view(std::span<const std::uint64_t>(x), sign).value();
+    }
+
+    int compare(const limbs& a, const limbs& b)
+    {
+        if(a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+
+        for(std::size_t i = a.size(); i-- > 0; )
+            if(a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+
+        return 0;
+    }
+
+    limbs add(const limbs& a, const limbs& b)
+    {
+        limbs r(std::max(a.size(), b.size()) + 1);
+        std::uint64_t carry = 0;
+        for(std::size_t i = 0; i < r.size(); ++i)
+        {
+            const std::uint64_t x = i < a.size() ? a[i] : 0, y = i < b.size() ? b[i] : 0;
+            const std::uint64_t s = x + y;
+            r[i] = s + carry;
+            carry = (s < x) || (r[i] < s);
+        }
+
+        trim(r);
+        return r;
+    }
+
+    // 要求 a >= b
+    limbs subtract(const limbs& a, const limbs& b)
+    {
+        limbs r(a.size());
+        std::uint64_t borrow = 0;
+        for(std::size_t i = 0; i < a.size(); ++i)
+        {
+            const std::uint64_t y = i < b.size() ? b[i] : 0;
+            r[i] = a[i] - y - borrow;
+            borrow = (a[i] < y) || (a[i] - y < borrow);
+        }
+
+        trim(r);
+        return r;
+    }
+
+    limbs shift_left(const limbs& a, const std::size_t shift)
+    {
+        if(a.empty())
+            return a;
+
+        limbs r(a.size() + shift / 64 + 1);
+        for(std::size_t i = 0; i < a.size() * 64; ++i)
+            if(a[i / 64] >> (i % 64) & 1)
+                r[(i + shift) / 64] |= std::uint64_t(1) << ((i + shift) % 64);
+
+        trim(r);
+        return r;
+    }
+
+    limbs shift_right(const limbs& a, const std::size_t shift)
+    {
+        limbs r(a.size());
+        for(std::size_t i = shift; i < a.size() * 64; ++i)
+            if(a[i / 64] >> (i % 64) & 1)
+                r[(i - shift) / 64] |= std::uint64_t(1) << ((i - shift) % 64);
+
+        trim(r);
+        return r;
+    }
+
+    // 带符号的参考加法：a + sign_b * b
+    vinteger reference_add(const vinteger& a, const vinteger& b, const int sign_b)
+    {
+        const limbs x = magnitude(a), y = magnitude(b);
+        const int sa = a.sign(), sb = b.sign() * sign_b;
+        if(sa == 0)
+            return make(y, sb);
+        if(sb == 0)
+            return make(x, sa);
+        if(sa == sb)
+            return make(add(x, y), sa);
+
+        const int c = compare(x, y);
+        return c >= 0 ? make(subtract(x, y), sa) : make(subtract(y, x), sb);
+    }
+
+
+
+    // ****** 检查 ******
+    [[noreturn]] void fail(const char* what, const vinteger& a, const vinteger& b)
+    {
+        std::cerr << "vinteger_fuzz: " << what << " mismatch\n"
+                  << "  a = " << a.to_string() << "\n"
+                  << "  b = " << b.to_string() << "\n";
+        const vinteger_thresholds& t = thresholds();
+        std::cerr << "  thresholds: " << t.karatsuba << " " << t.radix_leaf << " " << t.half_gcd << " " << t.accumulator_product << "\n";
+        std::abort();
+    }
+
+    bool same(const vinteger& x, const vinteger& y) {
+        return std::is_eq(x <=> y) && x.sign() == y.sign() && x.value_bit_width() == y.value_bit_width();
+    }
+
+    void check_add(const vinteger& a, const vinteger& b)
+    {
+        if(!same(a + b, reference_add(a, b, 1)))
+            fail("a + b", a, b);
+
+        if(!same(a - b, reference_add(a, b, -1)))
+            fail("a - b", a, b);
+
+        vinteger c = a;
+        c += b, c -= b;
+        if(!same(c, a))
+            fail("a += b; a -= b", a, b);
+    }
+
+    void check_compare(const vinteger& a, const vinteger& b)
+    {
+        const limbs x = magnitude(a), y = magnitude(b);
+        int expected = a.sign() != b.sign() ? (a.sign() < b.sign() ? -1 : 1) : a.sign() * compare(x, y);
+        const std::strong_ordering r = a <=> b;
+        if((expected < 0) != std::is_lt(r) || (expected > 0) != std::is_gt(r))
+            fail("a <=> b", a, b);
+    }
+
+    void check_multiply(const vinteger& a, const vinteger& b)
+    {
+        const vinteger p = a * b;
+        if(!same(p, b * a))
+            fail("a * b commutativity", a, b);
+
+        if(magnitude(a).size() <= naive_limbs && magnitude(b).size() <= naive_limbs && !same(p, __naive_multiply(a, b)))
+            fail("a * b against naive", a, b);
+
+        if(!same(mul(a, b, exec_policy{4, 8}), p))
+            fail("parallel mul", a, b);
+
+        if(!same(a * (b + 1), p + a))
+            fail("a * (b + 1)", a, b);
+
+        // 累加器的两条路径：逐列累加部分积与先求乘积
+        vinteger_accumulator accumulator(a);
+        accumulator.addmul(a, b);
+        accumulator.submul(b, a);
+        if(!same(accumulator.value(), a))
+            fail("accumulator addmul / submul", a, b);
+    }
+
+    void check_divide(const vinteger& a, const vinteger& b)
+    {
+        if(b.empty())
+            return;
+
+        const vinteger q = a / b, r = a % b;
+
+        // a = q * b + r，|r| < |b|，r 与 a 同号（或为 0）
+        if(!same(q * b + r, a))
+            fail("a = q * b + r", a, b);
+
+        if(compare(magnitude(r), magnitude(b)) >= 0 || (!r.empty() && r.sign() != a.sign()))
+            fail("remainder range", a, b);
+
+        if(a.sign() > 0 && b.sign() > 0 && magnitude(a).size() <= naive_limbs && !same(q, __naive_divide(a, b)))
+            fail("a / b against naive", a, b);
+
+        // 一次除法的各种取整方式由截断的结果修正得到
+        const auto [dq, dr] = divmod(a, b);
+        if(!same(dq, q) || !same(dr, r))
+            fail("divmod", a, b);
+
+        vinteger fr, cr;
+        const vinteger fq = fdiv_qr(a, b, fr), cq = cdiv_qr(a, b, cr);
+        const bool exact = r.empty();
+        if(!same(fq * b + fr, a) || compare(magnitude(fr), magnitude(b)) >= 0 || (!fr.empty() && fr.sign() != b.sign()) || !same(fq, exact || a.sign() == b.sign() ? q : q - 1))
+            fail("fdiv_qr", a, b);
+
+        if(!same(cq * b + cr, a) || compare(magnitude(cr), magnitude(b)) >= 0 || (!cr.empty() && cr.sign() == b.sign()) || !same(cq, exact || a.sign() != b.sign() ? q : q + 1))
+            fail("cdiv_qr", a, b);
+
+        // a - r 被 b 整除
+        if(!same(divexact(a - r, b), q))
+            fail("divexact", a, b);
+    }
+
+    void check_shift(const vinteger& a, const std::size_t shift)
+    {
+        const limbs x = magnitude(a);
+        if(!same(a << shift, make(shift_left(x, shift), a.sign())))
+            fail("a << shift", a, vinteger(shift));
+
+        if(!same(a >> shift, make(shift_right(x, shift), a.sign())))
+            fail("a >> shift", a, vinteger(shift));
+
+        // div_2exp / mod_2exp 与除以 2^shift 的向下取整除法一致
+        vinteger r;
+        if(!same(div_2exp(a, shift), fdiv_qr(a, vinteger(1) << shift, r)) || !same(mod_2exp(a, shift), r))
+            fail("div_2exp / mod_2exp", a, vinteger(shift));
+    }
+
+    void check_string(const vinteger& a)
+    {
+        const std::string s = a.to_string();
+        if(!same(vinteger(s), a))
+            fail("string round trip", a, vinteger(0));
+
+        if(!same(vinteger(s, exec_policy{4, 8}), a) || a.to_string(exec_policy{4, 8}) != s)
+            fail("parallel string conversion", a, vinteger(0));
+    }
+
+    void check_gcd(const vinteger& a, const vinteger& b)
+    {
+        vinteger s, t;
+        const vinteger g = gcdext(a, b, s, t);
+        if(!same(g, gcd(a, b)))
+            fail("gcdext against gcd", a, b);
+
+        if(!same(a * s + b * t, g))
+            fail("Bezout identity", a, b);
+
+        if(!g.empty() && (!(a % g).empty() || !(b % g).empty()))
+            fail("gcd divides operands", a, b);
+    }
+
+
+    // r = iroot(a, k) 满足 |r|^k <= |a| < (|r| + 1)^k，且与 a 同号；偶数次方根只检查非负数
+    void check_root(const vinteger& a, const std::uint64_t k)
+    {
+        if(a.sign() < 0 && k % 2 == 0)
+            return;
+
+        const vinteger r = iroot(a, k);
+        const vinteger magnitude = a.sign() < 0 ? -a : a, root = r.sign() < 0 ? -r : r;
+        if(r.sign() != a.sign() && !r.empty())
+            fail("sign of iroot(a, k)", a, vinteger(k));
+
+        if(pow(root, k) > magnitude || pow(root + 1, k) <= magnitude)
+            fail("iroot(a, k)", a, vinteger(k));
+    }
+
+    // vinteger 取模 2^Bits 后的值，有符号时按二进制补码解释为 [-2^(Bits-1), 2^(Bits-1))
+    template<std::size_t Bits, bool Signed>
+    vinteger wrap(const vinteger& x)
+    {
+        vinteger r = mod_2exp(x, Bits);
+        if(Signed && r.value_bit_width() == Bits)
+            r -= vinteger(1) << Bits;
+
+        return r;
+    }
+
+    // fixed_int 以 vinteger 为基准：运算结果应等于 vinteger 上的结果回绕到 Bits 位
+    template<std::size_t Bits, bool Signed>
+    void check_fixed(const vinteger& a, const vinteger& b, const std::size_t shift)
+    {
+        using fixed = fixed_int<Bits, Signed>;
+        const vinteger x = wrap<Bits, Signed>(a), y = wrap<Bits, Signed>(b);
+        const fixed fx(a), fy(b);
+
+        const auto expect = [&](const char* what, const fixed& result, const vinteger& reference)
+        {
+            if(!same(vinteger(result), wrap<Bits, Signed>(reference)))
+                fail(what, x, y);
+        };
+
+        if(!same(vinteger(fx), x) || fx.to_string() != x.to_string() || fixed(x.to_string()) != fx)
+            fail("fixed_int conversion", a, vinteger(Bits));
+
+        expect("fixed_int a + b", fx + fy, x + y);
+        expect("fixed_int a - b", fx - fy, x - y);
+        expect("fixed_int a * b", fx * fy, x * y);
+        expect("fixed_int a << shift", fx << shift, x << shift);
+        expect("fixed_int a >> shift", fx >> shift, div_2exp(x, shift));
+
+        if(!y.empty())
+        {
+            expect("fixed_int a / b", fx / fy, x / y);
+            expect("fixed_int a % b", fx % fy, x % y);
+        }
+
+        if((fx <=> fy) != (x <=> y))
+            fail("fixed_int compare", x, y);
+    }
+
+    // 超过 2^32 位的数值：位宽与容量都须按 64 位计算，移位距离与计算单元下标也不能截断为 32 位
+    // 每个数值约占 512 MiB，只与短操作数做线性代价的运算
+    void check_huge(const vinteger& a, const vinteger& b, const std::size_t extra)
+    {
+        const std::size_t shift = (std::size_t(1) << 32) + extra;
+        const vinteger x = a << shift;
+        if(x.value_bit_width() != a.value_bit_width() + shift || x.sign() != a.sign())
+            fail("bit width of a << 2^32", a, vinteger(shift));
+
+        if(!same(x >> shift, a) || !same(x >> (shift - 64), a << 64))
+            fail("a << 2^32 >> 2^32", a, vinteger(shift));
+
+        const vinteger y = x * b;
+        if(y.value_bit_width() != (a * b).value_bit_width() + shift)
+            fail("bit width of (a << 2^32) * b", a, b);
+
+        if(!same(y >> shift, a * b) || !mod_2exp(y, shift).empty())
+            fail("(a << 2^32) * b", a, b);
+
+        if(!std::is_lt(x <=> (x + 1)) || !std::is_gt(x <=> (x - 1)))
+            fail("compare around a << 2^32", a, vinteger(shift));
+    }
+
+
+
+    // ****** 操作数 ******
+    // 长度取在各算法阈值附近
+    std::size_t operand_length(fuzz_input& in)
+    {
+        const vinteger_thresholds& t = thresholds();
+        const std::size_t anchors[] = {0, 1, 2, t.karatsuba, 2 * t.karatsuba, t.radix_leaf, t.accumulator_product + 1, t.half_gcd};
+
+        std::size_t length;
+        const std::uint8_t kind = in.byte() % 4;
+        if(kind == 0)
+            length = in.below(max_limbs + 1);
+        else
+        {
+            const std::size_t anchor = anchors[in.byte() % std::size(anchors)];
+            length = std::max<std::ptrdiff_t>(0, std::ptrdiff_t(anchor) + std::ptrdiff_t(in.byte() % 5) - 2);
+        }
+
+        return std::min(length, max_limbs);
+    }
+
+    vinteger operand(fuzz_input& in)
+    {
+        const std::size_t length = operand_length(in);
+        limbs x(length);
+
+        switch(in.byte() % 6)
+        {
+            case 0:
+                // 全 1：加法与减法的进位、借位贯穿整个数
+                std::fill(x.begin(), x.end(), ~std::uint64_t(0));
+                break;
+            case 1:
+                // 2 的幂：最高计算单元只有一位，位宽恰好跨越计算单元边界
+                if(length)
+                    x.back() = std::uint64_t(1) << (in.byte() % 64);
+                break;
+            case 2:
+            {
+                // 稀疏：大部分计算单元为 0
+                std::uint64_t state = in.word();
+                for(std::uint64_t& limb : x)
+                    limb = fuzz_input::next(state) % 8 == 0 ? fuzz_input::next(state) : 0;
+                if(length)
+                    x.back() |= 1;
+                break;
+            }
+            case 3:
+                // 高位全 1、低位全 0
+                for(std::size_t i = 0; i < length; ++i)
+                    x[i] = i >= length / 2 ? ~std::uint64_t(0) : 0;
+                break;
+            default:
+            {
+                std::uint64_t state = in.word();
+                for(std::uint64_t& limb : x)
+                    limb = fuzz_input::next(state);
+                break;
+            }
+        }
+
+        trim(x);
+        vinteger result = make(x);
+
+        // 2^k - 1 与 2^k + 1 形式的邻近值
+        if(in.byte() % 4 == 0)
+            result += in.byte() % 2 ? 1 : -1;
+
+        return in.byte() % 3 == 0 ? -result : result;
+    }
+
+    // 第一个字节为偶数时使用随机的小阈值，使递归在小规模上就经过每一层
+    void choose_thresholds(fuzz_input& in)
+    {
+        static const vinteger_thresholds defaults = thresholds();
+        if(in.byte() % 2)
+        {
+            set_thresholds(defaults);
+            return;
+        }
+
+        vinteger_thresholds t;
+        t.karatsuba = 2 + in.byte() % 48;
+        t.radix_leaf = 1 + in.byte() % 32;
+        t.half_gcd = 2 + in.byte() % 64;
+        t.accumulator_product = in.byte() % 48;
+        set_thresholds(t);
+    }
+
+    void run_one(fuzz_input& in)
+    {
+        choose_thresholds(in);
+
+        do
+        {
+            const std::uint8_t op = in.byte() % 9;
+            const vinteger a = operand(in), b = operand(in);
+
+            switch(op)
+            {
+                case 0: check_add(a, b); break;
+                case 1: check_compare(a, b); break;
+                case 2: check_multiply(a, b); break;
+                case 3: check_divide(a, b); break;
+                case 4: check_shift(a, in.below(64 * 8 + 1)); break;
+                case 5: check_string(a); break;
+                case 6: check_gcd(a, b); break;
+                case 7: check_root(a, 1 + in.below(5)); break;
+                default:
+                    switch(in.byte() % 4)
+                    {
+                        case 0: check_fixed<128, false>(a, b, in.below(129)); break;
+                        case 1: check_fixed<128, true>(a, b, in.below(129)); break;
+                        case 2: check_fixed<256, false>(a, b, in.below(257)); break;
+                        default: check_fixed<256, true>(a, b, in.below(257)); break;
+                    }
+                    break;
+            }
+        }
+        while(in.more());
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    max_limbs = 64;
+    fuzz_input in{data, size};
+    run_one(in);
+    return 0;
+}
+
+#if !defined(ALGAE_VINTEGER_LIBFUZZER)
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::size_t iterations = 10000, huge = 0;
+        std::uint64_t seed = std::random_device()();
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if(i + 1 >= argc)
+                throw std::invalid_argument(arg + " requires a value");
+
+            if(arg == "--iterations")
+                iterations = std::stoull(argv[++i]);
+            else if(arg == "--seed")
+                seed = std::stoull(argv[++i]);
+            else if(arg == "--max-limbs")
+                max_limbs = std::stoull(argv[++i]);
+            else if(arg == "--huge")
+                huge = std::stoull(argv[++i]);
+            else
+                throw std::invalid_argument("unknown argument " + arg);
+        }
+
+        std::cerr << "vinteger_fuzz: seed " << seed << std::endl;
+
+        // 回归用例：单计算单元、接近 2^64 的负数的一次与奇数次方根
+        for(const vinteger& a : {-vinteger(std::uint64_t(-1)), -vinteger(std::uint64_t(-1) - 1), vinteger(std::uint64_t(-1))})
+            for(const std::uint64_t k : {1, 3, 5})
+                check_root(a, k);
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint8_t> data;
+        for(std::size_t i = 0; i < iterations; ++i)
+        {
+            data.resize(1 + rng() % 256);
+            for(std::uint8_t& byte : data)
+                byte = std::uint8_t(rng());
+
+            fuzz_input in{data.data(), data.size()};
+            run_one(in);
+        }
+
+        for(std::size_t i = 0; i < huge; ++i)
+        {
+            std::uint8_t bytes[32];
+            for(std::uint8_t& byte : bytes)
+                byte = std::uint8_t(rng());
+
+            fuzz_input in{bytes, sizeof(bytes)};
+            limbs x{in.word() | 1};
+            if(in.below(3))
+                x.push_back(in.word() | 1);
+
+            const vinteger a = make(x, in.byte() % 2 ? 1 : -1);
+            const vinteger b = make(limbs{in.word() | 1}, in.byte() % 2 ? 1 : -1);
+            check_huge(a, b, in.below(128));
+        }
+
+        std::cout << iterations + huge << " cases passed\n";
+        return 0;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "vinteger_fuzz: " << e.what() << "\n";
+        return 1;
+    }
+}
+#endif
@@ -0,0 +1,539 @@
+#include "vinteger_kernel.h"
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace algae
+{
+    struct gcd_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+#if defined(__SIZEOF_INT128__)
+        // 双精度 Lehmer：以两个计算单元宽的近似值推进商序列，辅因子不超过 62 位
+        using digit_type = unsigned __int128;
+        using signed_digit_type = __int128;
+        constexpr static std::size_t digit_bits = 124;
+        constexpr static std::int64_t cofactor_bound = std::int64_t(1) << 62;
+#else
+        // 没有 128 位整数时退化为单精度 Lehmer
+        using digit_type = std::uint64_t;
+        using signed_digit_type = std::int64_t;
+        constexpr static std::size_t digit_bits = 62;
+        constexpr static std::int64_t cofactor_bound = std::int64_t(1) << 31;
+#endif
+        constexpr static std::size_t digit_width = sizeof(digit_type) * 8;
+
+        // 较大操作数的计算单元长度达到该值后使用 half-GCD，见 vinteger_thresholds::half_gcd
+        static std::size_t hgcd_threshold() {
+            return thresholds().half_gcd;
+        }
+
+        // half-GCD 的递归在不超过该长度的子问题上改用 Lehmer 步，避免在很小的规模上做整数移位、复制与矩阵乘法
+        constexpr static std::size_t hgcd_base_limbs = 64;
+
+        // 商序列对应的 2x2 矩阵，(a, b)^T = M * (a', b')^T，各元素非负，行列式为 ±1
+        struct matrix
+        {
+            vinteger m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+            int det = 1;
+            bool identity = true;
+        };
+
+        bool extended = false;
+
+        // 当前的余数对，始终满足 a >= b >= 0
+        vinteger a, b;
+        // 扩展模式下的辅因子：a ≡ sa * |x|，b ≡ sb * |x| (mod |y|)
+        vinteger sa, sb;
+
+        gcd_context(const vinteger& x, const vinteger& y, bool extended)
+            :extended(extended), a(x.sign() < 0 ? -x : x), b(y.sign() < 0 ? -y : y)
+        {
+            if(a < b)
+            {
+                std::swap(a, b);
+                sa = 0, sb = 1;
+            }
+            else
+                sa = 1, sb = 0;
+
+            run();
+        }
+
+
+
+        // 计算 p * x - q * y，调用方保证结果非负
+        static vinteger linear_combination(const vinteger& x, const __CUtype p, const vinteger& y, const __CUtype q)
+        {
+            const std::size_t x_length = x.__value_length(), y_length = y.__value_length();
+            const std::size_t length = std::max(x_length, y_length);
+
+            vinteger result;
+            result.__change_capacity(length + 1);
+
+            __CUtype carry_x = 0, carry_y = 0, high = 0;
+            bool retreat = false;
+
+            for(std::size_t i = 0; i < length; ++i)
+            {
+                __CUtype px = vinteger::__multiply_unit(p, i < x_length ? x.__buffer[i] : 0, high);
+                px += carry_x, carry_x = high + (px < carry_x);
+
+                __CUtype qy = vinteger::__multiply_unit(q, i < y_length ? y.__buffer[i] : 0, high);
+                qy += carry_y, carry_y = high + (qy < carry_y);
+
+                result.__buffer[i] = px - qy - retreat;
+                retreat = px < qy || (px == qy && retreat);
+            }
+
+            result.__buffer[length] = carry_x - carry_y - retreat;
+            result.__refresh_bit_length(length + 1);
+            return result;
+        }
+
+        // 计算 p * x + q * y
+        static vinteger linear_sum(const vinteger& x, const __CUtype p, const vinteger& y, const __CUtype q)
+        {
+            const std::size_t x_length = x.__value_length(), y_length = y.__value_length();
+            const std::size_t length = std::max(x_length, y_length);
+
+            vinteger result;
+            result.__change_capacity(length + 1);
+
+            __CUtype carry_x = 0, carry_y = 0, high = 0;
+            bool carry = false;
+
+            for(std::size_t i = 0; i < length; ++i)
+            {
+                __CUtype px = vinteger::__multiply_unit(p, i < x_length ? x.__buffer[i] : 0, high);
+                px += carry_x, carry_x = high + (px < carry_x);
+
+                __CUtype qy = vinteger::__multiply_unit(q, i < y_length ? y.__buffer[i] : 0, high);
+                qy += carry_y, carry_y = high + (qy < carry_y);
+
+                result.__buffer[i] = full_adder(px, qy, carry);
+            }
+
+            result.__buffer[length] = carry_x + carry_y + carry;
+            result.__refresh_bit_length(length + 1);
+            return result;
+        }
+
+        // 取 x >> shift 的低 digit_width 位
+        static digit_type top_bits(const vinteger& x, const std::size_t shift)
+        {
+            const std::size_t unit = shift / __CUtype_bit_length, bit = shift % __CUtype_bit_length;
+            const std::size_t length = x.__value_length();
+
+            digit_type value = 0;
+            for(std::size_t j = 0; j <= digit_width / __CUtype_bit_length; ++j)
+            {
+                const digit_type limb = unit + j < length ? x.__buffer[unit + j] : 0;
+                const std::size_t position = j * __CUtype_bit_length;
+
+                if(position < bit)
+                    value |= limb >> (bit - position);
+                else if(position - bit < digit_width)
+                    value |= limb << (position - bit);
+            }
+
+            return value;
+        }
+
+        static std::uint64_t low_unit(const vinteger& x) {
+            return x.empty() ? 0 : x.__buffer[0];
+        }
+
+        // p * x + q * y，其中 p 与 q 异号或其一为 0，且结果非负
+        static vinteger combine(const vinteger& x, const vinteger& y, const std::int64_t p, const std::int64_t q)
+        {
+            if(p >= 0 && q <= 0)
+                return linear_combination(x, p, y, -q);
+
+            return linear_combination(y, q, x, -p);
+        }
+
+        // 近似值的二进制位宽，非正数为 0
+        static std::size_t digit_bit_width(const signed_digit_type v)
+        {
+            if(v <= 0)
+                return 0;
+
+            const digit_type u = digit_type(v);
+            std::size_t width = 0;
+            for(std::size_t i = 0; i < digit_width; i += __CUtype_bit_length)
+                if(const std::uint64_t part = std::uint64_t(u >> i))
+                    width = i + std::size_t(std::bit_width(part));
+
+            return width;
+        }
+
+        // Lehmer 的辅因子：(x, y) 推进若干步后为 (A * x + B * y, C * x + D * y)
+        struct cofactors
+        {
+            std::int64_t A = 1, B = 0, C = 0, D = 1;
+        };
+
+        // Lehmer 步（Knuth 4.5.2 算法 L）：仅用 x 与 y 的高位推进商序列
+        // 当由近似值上下界得到的两个商一致时，该商必为真实的商；累计的辅因子矩阵最后一次性作用到 x 与 y 上
+        // limit 非 0 时，在近似的余数或相邻余数之差降到约 limit 位之前停止，供 half-GCD 的基础情形使用
+        // 一步都无法推进时返回 false，此时需要做一次完整的带余除法
+        static bool lehmer_cofactors(const vinteger& x, const vinteger& y, const std::size_t limit, cofactors& f)
+        {
+            const std::size_t n = x.value_bit_width();
+            const std::size_t shift = n > digit_bits ? n - digit_bits : 0;
+            const std::size_t floor = limit > shift ? limit - shift : 0;
+
+            signed_digit_type ah = top_bits(x, shift), bh = top_bits(y, shift);
+            std::int64_t A = 1, B = 0, C = 0, D = 1;
+
+            while(bh + C != 0 && bh + D != 0)
+            {
+                const signed_digit_type q = (ah + A) / (bh + C);
+                if(q != (ah + B) / (bh + D) || q >= cofactor_bound)
+                    break;
+
+                const signed_digit_type next_c = A - q * C, next_d = B - q * D;
+                if(next_c >= cofactor_bound || next_c <= -cofactor_bound || next_d >= cofactor_bound || next_d <= -cofactor_bound)
+                    break;
+
+                const signed_digit_type next_bh = ah - q * bh;
+                if(floor && (digit_bit_width(next_bh) <= floor || digit_bit_width(bh - next_bh) <= floor))
+                    break;
+
+                A = C, C = std::int64_t(next_c);
+                B = D, D = std::int64_t(next_d);
+                ah = bh, bh = next_bh;
+            }
+
+            f = cofactors{A, B, C, D};
+            return B != 0;
+        }
+
+        bool lehmer_step()
+        {
+            cofactors f;
+            if(!lehmer_cofactors(a, b, 0, f))
+                return false;
+
+            vinteger next_a = combine(a, b, f.A, f.B), next_b = combine(a, b, f.C, f.D);
+
+            if(extended)
+            {
+                vinteger next_sa = sa * f.A + sb * f.B;
+                vinteger next_sb = sa * f.C + sb * f.D;
+                sa = std::move(next_sa), sb = std::move(next_sb);
+            }
+
+            a = std::move(next_a), b = std::move(next_b);
+            return true;
+        }
+
+        // 完整的带余除法步：(a, b) <- (b, a mod b)
+        void division_step()
+        {
+            if(!extended)
+            {
+                vinteger r = a % b;
+                a = std::move(b), b = std::move(r);
+                return;
+            }
+
+            vinteger q = a / b;
+            vinteger r = a - q * b;
+            vinteger s = sa - q * sb;
+
+            a = std::move(b), b = std::move(r);
+            sa = std::move(sb), sb = std::move(s);
+        }
+
+
+
+        // M <- M * [[q, 1], [1, 0]]
+        static void push_quotient(matrix& m, const vinteger& q)
+        {
+            vinteger m00 = m.m00 * q + m.m01;
+            vinteger m10 = m.m10 * q + m.m11;
+
+            m.m01 = std::move(m.m00), m.m00 = std::move(m00);
+            m.m11 = std::move(m.m10), m.m10 = std::move(m10);
+            m.det = -m.det;
+            m.identity = false;
+        }
+
+        static matrix multiply(const matrix& x, const matrix& y)
+        {
+            if(x.identity)
+                return y;
+
+            if(y.identity)
+                return x;
+
+            matrix r;
+            r.m00 = x.m00 * y.m00 + x.m01 * y.m10;
+            r.m01 = x.m00 * y.m01 + x.m01 * y.m11;
+            r.m10 = x.m10 * y.m00 + x.m11 * y.m10;
+            r.m11 = x.m10 * y.m01 + x.m11 * y.m11;
+            r.det = x.det * y.det;
+            r.identity = false;
+            return r;
+        }
+
+        // (x, y)^T <- M^-1 * (x, y)^T
+        static void transform(const matrix& m, vinteger& x, vinteger& y)
+        {
+            vinteger next_x = m.m11 * x - m.m01 * y;
+            vinteger next_y = m.m00 * y - m.m10 * x;
+
+            if(m.det < 0)
+                next_x = -next_x, next_y = -next_y;
+
+            x = std::move(next_x), y = std::move(next_y);
+        }
+
+        // x > y >= 0 时判断是否满足 y >= 2^s 且 x - y >= 2^s
+        // half-GCD 的输出始终保持该性质，截断后求得的矩阵才能安全地作用到完整的操作数上
+        static bool reducible(const vinteger& x, const vinteger& y, const std::size_t s) {
+            return y.value_bit_width() > s && (x - y).value_bit_width() > s;
+        }
+
+        // 将子问题的矩阵 t 作用到 (c, d) 上并累计到 r 中
+        // 截断引理保证结果仍是余数序列中的相邻两项，边界情形下仍做一次精确检查，不满足时丢弃 t
+        static bool apply(matrix& r, const matrix& t, vinteger& c, vinteger& d, const std::size_t s)
+        {
+            if(t.identity)
+                return false;
+
+            vinteger next_c = c, next_d = d;
+            transform(t, next_c, next_d);
+
+            if(next_d.sign() < 0 || next_c <= next_d || !reducible(next_c, next_d, s))
+                return false;
+
+            r = multiply(r, t);
+            c = std::move(next_c), d = std::move(next_d);
+            return true;
+        }
+
+        // 带余除法推进一步，结果不再满足 reducible 时不做修改
+        static bool euclid_step(matrix& r, vinteger& c, vinteger& d, const std::size_t s)
+        {
+            vinteger q = c / d;
+            vinteger remainder = c - q * d;
+
+            if(!reducible(d, remainder, s))
+                return false;
+
+            push_quotient(r, q);
+            c = std::move(d), d = std::move(remainder);
+            return true;
+        }
+
+        // 不超过一个计算单元时直接用机器整数推进商序列
+        // std::bit_width 的返回类型随标准库版本不同（T 或 int），统一转换为 std::size_t 再比较
+        static matrix hgcd_unit(std::uint64_t x, std::uint64_t y, const std::size_t s)
+        {
+            std::uint64_t m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+
+            matrix r;
+            for(;;)
+            {
+                const std::uint64_t q = x / y, remainder = x - q * y;
+                if(std::size_t(std::bit_width(remainder)) <= s || std::size_t(std::bit_width(y - remainder)) <= s)
+                    break;
+
+                std::swap(m00, m01), m00 += q * m01;
+                std::swap(m10, m11), m10 += q * m11;
+                r.det = -r.det;
+                r.identity = false;
+
+                x = y, y = remainder;
+            }
+
+            r.m00 = m00, r.m01 = m01, r.m10 = m10, r.m11 = m11;
+            return r;
+        }
+
+        // half-GCD 的基础情形：不再递归，以 Lehmer 步推进并累计矩阵
+        // 辅因子矩阵 [[A, B], [C, D]] 的逆为 [[|D|, |B|], [|C|, |A|]]，行列式同为 ±1
+        // 近似值无法精确判断停止位置，推进后结果不满足 reducible 时放弃这一步，加大余量重试，最后以带余除法收尾
+        static matrix hgcd_lehmer(const vinteger& x, const vinteger& y, const std::size_t s)
+        {
+            matrix r;
+            vinteger c = x, d = y;
+            std::size_t margin = 2;
+
+            for(;;)
+            {
+                cofactors f;
+                if(lehmer_cofactors(c, d, s + margin, f))
+                {
+                    vinteger next_c = combine(c, d, f.A, f.B), next_d = combine(c, d, f.C, f.D);
+                    if(next_c > next_d && reducible(next_c, next_d, s))
+                    {
+                        // r <- r * [[|D|, |B|], [|C|, |A|]]，辅因子不超过一个计算单元，按线性组合计算
+                        const __CUtype A = std::abs(f.A), B = std::abs(f.B), C = std::abs(f.C), D = std::abs(f.D);
+                        vinteger m00 = linear_sum(r.m00, D, r.m01, C), m01 = linear_sum(r.m00, B, r.m01, A);
+                        vinteger m10 = linear_sum(r.m10, D, r.m11, C), m11 = linear_sum(r.m10, B, r.m11, A);
+
+                        r.m00 = std::move(m00), r.m01 = std::move(m01), r.m10 = std::move(m10), r.m11 = std::move(m11);
+                        // 每推进一步行列式变号，D 的符号也随之交替，二者一致
+                        r.det = f.D > 0 ? r.det : -r.det;
+                        r.identity = false;
+                        c = std::move(next_c), d = std::move(next_d);
+                        continue;
+                    }
+
+                    margin += digit_bits / 4;
+                    continue;
+                }
+
+                if(!euclid_step(r, c, d, s))
+                    return r;
+            }
+        }
+
+        // half-GCD（Möller 的形式）：x > y >= 0，记 n = bit_width(x)，s = n / 2 + 1
+        // 返回商序列矩阵 M，使 (c, d) = M^-1 * (x, y) 满足 reducible(c, d, s)，且 c 约为 n / 2 位
+        // 前半段递归处理高位的一半，后半段在剩余规模上再递归一次，总代价为 O(M(n) log n)
+        static matrix hgcd(const vinteger& x, const vinteger& y)
+        {
+            const std::size_t n = x.value_bit_width(), s = n / 2 + 1;
+            if(!reducible(x, y, s))
+                return matrix();
+
+            if(n <= __CUtype_bit_length)
+                return hgcd_unit(low_unit(x), low_unit(y), s);
+
+            if(x.__value_length() <= hgcd_base_limbs)
+                return hgcd_lehmer(x, y, s);
+
+            matrix r;
+            vinteger c = x, d = y;
+
+            const std::size_t p = n / 2;
+            apply(r, hgcd(x >> p, y >> p), c, d, s);
+
+            if(!euclid_step(r, c, d, s))
+                return r;
+
+            // 子问题的输出约为 p + (k - p) / 2 + 1 位，多留两位余量使其边界情形也能满足 reducible
+            const std::size_t k = c.value_bit_width();
+            const std::size_t q = 2 * s + 2 - k;
+            apply(r, hgcd(c >> q, d >> q), c, d, s);
+
+            while(euclid_step(r, c, d, s));
+
+            return r;
+        }
+
+        // 对足够大的操作数执行一次 half-GCD，将规模减半
+        bool hgcd_step()
+        {
+            const matrix m = hgcd(a, b);
+            if(m.identity)
+                return false;
+
+            transform(m, a, b);
+            if(extended)
+                transform(m, sa, sb);
+
+            return true;
+        }
+
+
+
+        void run()
+        {
+            while(!b.empty())
+            {
+                // 不需要辅因子时，单计算单元的收尾交给二进制 GCD
+                if(!extended && a.value_bit_width() <= __CUtype_bit_length)
+                {
+                    a = std::gcd(low_unit(a), low_unit(b));
+                    b.clear();
+                    break;
+                }
+
+                if(a.__value_length() >= hgcd_threshold() && hgcd_step())
+                    continue;
+
+                if(lehmer_step())
+                    continue;
+
+                division_step();
+            }
+        }
+    };
+
+
+
+    vinteger gcd(const vinteger& a, const vinteger& b)
+    {
+        gcd_context context(a, b, false);
+        return std::move(context.a);
+    }
+
+    vinteger lcm(const vinteger& a, const vinteger& b)
+    {
+        if(a.empty() || b.empty())
+            return 0;
+
+        vinteger result = divexact(a.sign() < 0 ? -a : a, gcd(a, b)) * b;
+        return result.sign() < 0 ? -result : result;
+    }
+
+    vinteger gcdext(const vinteger& a, const vinteger& b, vinteger& s, vinteger& t)
+    {
+        gcd_context context(a, b, true);
+        vinteger g = std::move(context.a);
+
+        if(g.empty())
+        {
+            s.clear(), t.clear();
+            return g;
+        }
+
+        // g = s * |a| + t * |b|
+        s = std::move(context.sa);
+        if(b.empty())
+            t.clear();
+        else
+        {
+            // t = (g - s * |a|) / |b|，整除
+            t = divexact(g - s * (a.sign() < 0 ? -a : a), b.sign() < 0 ? -b : b);
+        }
+
+        if(a.sign() < 0)
+            s = -s;
+
+        if(b.sign() < 0)
+            t = -t;
+
+        return g;
+    }
+
+    vinteger invert(const vinteger& a, const vinteger& m)
+    {
+        if(m.empty())
+            throw std::runtime_error("modulus is zero");
+
+        const vinteger modulus = m.sign() < 0 ? -m : m;
+
+        vinteger residue = (a.sign() < 0 ? -a : a) % modulus;
+        if(a.sign() < 0 && !residue.empty())
+            residue = modulus - residue;
+
+        vinteger s, t;
+        if(std::is_neq(gcdext(residue, modulus, s, t) <=> 1))
+            throw std::runtime_error("element is not invertible");
+
+        if(s.sign() < 0)
+            s += modulus;
+
+        return s % modulus;
+    }
+}
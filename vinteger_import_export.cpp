@@ -0,0 +1,206 @@
+#include "vinteger.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace algae
+{
+    struct import_export_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+        constexpr static std::size_t unit_bytes = sizeof(__CUtype);
+
+        static std::uint64_t swap_bytes(const std::uint64_t x)
+        {
+#if defined(__GNUC__)
+            return __builtin_bswap64(x);
+#else
+            std::uint64_t result = 0;
+            for(std::size_t i = 0; i < 8; ++i)
+                result |= (x >> (8 * i) & 0xff) << (8 * (7 - i));
+
+            return result;
+#endif
+        }
+
+        // 从 data 读取一个 word_size 字节的字（word_size 整除 8），按 endian 解释
+        static std::uint64_t load_word(const unsigned char* data, const std::size_t word_size, const std::endian endian)
+        {
+            std::uint64_t x = 0;
+            if constexpr(std::endian::native == std::endian::little)
+                std::memcpy(&x, data, word_size);
+            else
+                std::memcpy(reinterpret_cast<unsigned char*>(&x) + 8 - word_size, data, word_size);
+
+            // 字节序不同于本机时整体翻转，再移回低 word_size 字节
+            if(endian != std::endian::native)
+                x = swap_bytes(x) >> (64 - 8 * word_size);
+
+            return x;
+        }
+
+        static void store_word(unsigned char* out, std::uint64_t x, const std::size_t word_size, const std::endian endian)
+        {
+            if(endian != std::endian::native)
+                x = swap_bytes(x) >> (64 - 8 * word_size);
+
+            if constexpr(std::endian::native == std::endian::little)
+                std::memcpy(out, &x, word_size);
+            else
+                std::memcpy(out, reinterpret_cast<const unsigned char*>(&x) + 8 - word_size, word_size);
+        }
+
+        // 按数值从低到高的第 k 个字在缓冲区中的位置
+        static std::size_t word_offset(const std::size_t k, const std::size_t count, const std::size_t word_size, const word_order order) {
+            return (order == word_order::least_significant_first ? k : count - 1 - k) * word_size;
+        }
+
+        // 字内按数值从低到高的第 j 个字节在字中的位置
+        static std::size_t byte_offset(const std::size_t j, const std::size_t word_size, const std::endian endian) {
+            return endian == std::endian::little ? j : word_size - 1 - j;
+        }
+
+        // 整个缓冲区恰好是本机小端序的字节串时，可以直接整体复制；单字节的字没有字内字节序之分
+        static bool contiguous(const std::size_t count, const std::size_t word_size, const word_order order, const std::endian endian)
+        {
+            return std::endian::native == std::endian::little && (endian == std::endian::little || word_size == 1)
+                && (order == word_order::least_significant_first || count == 1);
+        }
+
+        static void check(const std::size_t word_size, const std::endian endian)
+        {
+            if(word_size == 0)
+                throw std::invalid_argument("word size is zero");
+
+            if(endian != std::endian::little && endian != std::endian::big)
+                throw std::invalid_argument("endianness must be little or big");
+        }
+
+        static vinteger import_words(const unsigned char* data, const std::size_t count, const std::size_t word_size, const word_order order, const std::endian endian)
+        {
+            vinteger result;
+            const std::size_t bytes = count * word_size;
+            const std::size_t length = (bytes + unit_bytes - 1) / unit_bytes;
+            if(length == 0)
+                return result;
+
+            // 只分配一次，所有路径都直接写入结果的缓冲区
+            result.__change_capacity(length, false, true);
+            __CUtype* units = result.__buffer;
+
+            if(contiguous(count, word_size, order, endian))
+                std::memcpy(units, data, bytes);
+            else if(unit_bytes % word_size == 0)
+            {
+                // 每个字恰好落在一个计算单元内
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    const std::uint64_t word = load_word(data + word_offset(k, count, word_size, order), word_size, endian);
+                    units[k * word_size / unit_bytes] |= word << (k * word_size % unit_bytes * 8);
+                }
+            }
+            else
+            {
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    const unsigned char* word = data + word_offset(k, count, word_size, order);
+                    for(std::size_t j = 0; j < word_size; ++j)
+                    {
+                        const std::size_t i = k * word_size + j;
+                        units[i / unit_bytes] |= __CUtype(word[byte_offset(j, word_size, endian)]) << (i % unit_bytes * 8);
+                    }
+                }
+            }
+
+            result.__refresh_bit_length(length);
+            return result;
+        }
+
+        static std::size_t export_count(const vinteger& x, const std::size_t word_size) {
+            return ((x.value_bit_width() + 7) / 8 + word_size - 1) / word_size;
+        }
+
+        static std::size_t export_words(const vinteger& x, unsigned char* out, const std::size_t word_size, const word_order order, const std::endian endian)
+        {
+            const std::size_t count = export_count(x, word_size);
+            if(count == 0)
+                return 0;
+
+            const std::size_t length = x.__value_length();
+            const __CUtype* units = x.__buffer;
+
+            // 超出数值的高位字节补 0
+            const auto unit_byte = [&](const std::size_t i) -> unsigned char {
+                return i / unit_bytes < length ? (unsigned char)(units[i / unit_bytes] >> (i % unit_bytes * 8)) : 0;
+            };
+
+            if(contiguous(count, word_size, order, endian))
+            {
+                const std::size_t bytes = count * word_size;
+                const std::size_t copied = std::min(bytes, length * unit_bytes);
+                std::memcpy(out, units, copied);
+                std::memset(out + copied, 0, bytes - copied);
+            }
+            else if(unit_bytes % word_size == 0)
+            {
+                const std::uint64_t mask = word_size == unit_bytes ? ~std::uint64_t(0) : (std::uint64_t(1) << (8 * word_size)) - 1;
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    const std::size_t unit = k * word_size / unit_bytes;
+                    const std::uint64_t word = unit < length ? units[unit] >> (k * word_size % unit_bytes * 8) & mask : 0;
+                    store_word(out + word_offset(k, count, word_size, order), word, word_size, endian);
+                }
+            }
+            else
+            {
+                for(std::size_t k = 0; k < count; ++k)
+                {
+                    unsigned char* word = out + word_offset(k, count, word_size, order);
+                    for(std::size_t j = 0; j < word_size; ++j)
+                        word[byte_offset(j, word_size, endian)] = unit_byte(k * word_size + j);
+                }
+            }
+
+            return count;
+        }
+    };
+
+
+
+    vinteger import_bits(const void* data, const std::size_t count, const std::size_t word_size, const word_order order, const std::endian endian)
+    {
+        import_export_context::check(word_size, endian);
+        return import_export_context::import_words(static_cast<const unsigned char*>(data), count, word_size, order, endian);
+    }
+
+    vinteger import_bits(const std::span<const std::byte> data, const std::size_t word_size, const word_order order, const std::endian endian)
+    {
+        import_export_context::check(word_size, endian);
+        if(data.size() % word_size != 0)
+            throw std::invalid_argument("data size is not a multiple of the word size");
+
+        return import_export_context::import_words(reinterpret_cast<const unsigned char*>(data.data()), data.size() / word_size, word_size, order, endian);
+    }
+
+    std::size_t export_count(const vinteger& x, const std::size_t word_size)
+    {
+        import_export_context::check(word_size, std::endian::little);
+        return import_export_context::export_count(x, word_size);
+    }
+
+    std::size_t export_bits(const vinteger& x, void* out, const std::size_t word_size, const word_order order, const std::endian endian)
+    {
+        import_export_context::check(word_size, endian);
+        return import_export_context::export_words(x, static_cast<unsigned char*>(out), word_size, order, endian);
+    }
+
+    std::vector<std::byte> export_bits(const vinteger& x, const std::size_t word_size, const word_order order, const std::endian endian)
+    {
+        import_export_context::check(word_size, endian);
+
+        std::vector<std::byte> result(import_export_context::export_count(x, word_size) * word_size);
+        import_export_context::export_words(x, reinterpret_cast<unsigned char*>(result.data()), word_size, order, endian);
+        return result;
+    }
+}
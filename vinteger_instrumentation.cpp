@@ -0,0 +1,238 @@
+#include "vinteger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace algae
+{
+    struct instrumentation_context
+    {
+        // 只由所属线程写入的计数器：写入是普通的读-改-写而不是原子加法，汇总线程只做宽松的读取
+        struct counter
+        {
+            std::atomic<std::uint64_t> value = 0;
+
+            void add(const std::uint64_t x) {
+                value.store(value.load(std::memory_order_relaxed) + x, std::memory_order_relaxed);
+            }
+
+            std::uint64_t get() const {
+                return value.load(std::memory_order_relaxed);
+            }
+        };
+
+        struct operation_counters
+        {
+            counter calls, limbs, nanoseconds;
+            counter size_histogram[65];
+            counter latency_histogram[65];
+            counter algorithms[vinteger_algorithm_count];
+        };
+
+        struct thread_counters
+        {
+            operation_counters operations[vinteger_operation_count];
+            counter allocations, allocated_limbs, releases;
+
+            thread_counters();
+            ~thread_counters();
+        };
+
+        struct registry
+        {
+            std::mutex mutex;
+            std::vector<thread_counters*> live;
+            // 已退出线程的统计，以及 reset 时记下的基准
+            vinteger_instrumentation retired, baseline;
+            std::map<std::size_t, instrumentation_exporter> exporters;
+            std::size_t next_exporter = 0;
+        };
+
+        // 不析构：线程池的工作线程在静态对象析构期间才退出，退出时仍须并入统计
+        static registry& shared()
+        {
+            static registry& value = *new registry;
+            return value;
+        }
+
+        static thread_counters& local()
+        {
+            thread_local thread_counters value;
+            return value;
+        }
+
+#if defined(ALGAE_VINTEGER_INSTRUMENTATION)
+        // 当前线程最内层的埋点作用域
+        static thread_local __instrumentation_scope* current;
+#endif
+
+        static std::int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        static void accumulate(vinteger_instrumentation& total, const thread_counters& c)
+        {
+            for(std::size_t i = 0; i < vinteger_operation_count; ++i)
+            {
+                vinteger_operation_stats& s = total.operations[i];
+                const operation_counters& o = c.operations[i];
+                s.calls += o.calls.get();
+                s.limbs += o.limbs.get();
+                s.nanoseconds += o.nanoseconds.get();
+                for(std::size_t j = 0; j < s.size_histogram.size(); ++j)
+                    s.size_histogram[j] += o.size_histogram[j].get(), s.latency_histogram[j] += o.latency_histogram[j].get();
+                for(std::size_t j = 0; j < vinteger_algorithm_count; ++j)
+                    s.algorithms[j] += o.algorithms[j].get();
+            }
+
+            total.allocations += c.allocations.get();
+            total.allocated_limbs += c.allocated_limbs.get();
+            total.releases += c.releases.get();
+        }
+
+        // total -= base，逐项相减
+        static void subtract(vinteger_instrumentation& total, const vinteger_instrumentation& base)
+        {
+            for(std::size_t i = 0; i < vinteger_operation_count; ++i)
+            {
+                vinteger_operation_stats& s = total.operations[i];
+                const vinteger_operation_stats& b = base.operations[i];
+                s.calls -= b.calls;
+                s.limbs -= b.limbs;
+                s.nanoseconds -= b.nanoseconds;
+                for(std::size_t j = 0; j < s.size_histogram.size(); ++j)
+                    s.size_histogram[j] -= b.size_histogram[j], s.latency_histogram[j] -= b.latency_histogram[j];
+                for(std::size_t j = 0; j < vinteger_algorithm_count; ++j)
+                    s.algorithms[j] -= b.algorithms[j];
+            }
+
+            total.allocations -= base.allocations;
+            total.allocated_limbs -= base.allocated_limbs;
+            total.releases -= base.releases;
+        }
+
+        // 不减去基准的累计值，调用方须持有 registry 的锁
+        static vinteger_instrumentation total(registry& r)
+        {
+            vinteger_instrumentation result = r.retired;
+            for(const thread_counters* c : r.live)
+                accumulate(result, *c);
+
+            return result;
+        }
+    };
+
+    instrumentation_context::thread_counters::thread_counters()
+    {
+        registry& r = shared();
+        std::lock_guard lock(r.mutex);
+        r.live.push_back(this);
+    }
+
+    // 线程退出时把统计并入 retired
+    instrumentation_context::thread_counters::~thread_counters()
+    {
+        registry& r = shared();
+        std::lock_guard lock(r.mutex);
+        accumulate(r.retired, *this);
+        r.live.erase(std::find(r.live.begin(), r.live.end(), this));
+    }
+
+
+
+    vinteger_instrumentation collect_instrumentation()
+    {
+        instrumentation_context::registry& r = instrumentation_context::shared();
+        std::lock_guard lock(r.mutex);
+        vinteger_instrumentation result = instrumentation_context::total(r);
+        instrumentation_context::subtract(result, r.baseline);
+        return result;
+    }
+
+    // 计数器只能由所属线程写入，因此重置只记下当前的累计值作为基准
+    void reset_instrumentation()
+    {
+        instrumentation_context::registry& r = instrumentation_context::shared();
+        std::lock_guard lock(r.mutex);
+        r.baseline = instrumentation_context::total(r);
+    }
+
+    std::size_t add_instrumentation_exporter(instrumentation_exporter exporter)
+    {
+        instrumentation_context::registry& r = instrumentation_context::shared();
+        std::lock_guard lock(r.mutex);
+        r.exporters.emplace(r.next_exporter, std::move(exporter));
+        return r.next_exporter++;
+    }
+
+    void remove_instrumentation_exporter(const std::size_t id)
+    {
+        instrumentation_context::registry& r = instrumentation_context::shared();
+        std::lock_guard lock(r.mutex);
+        r.exporters.erase(id);
+    }
+
+    void export_instrumentation()
+    {
+        const vinteger_instrumentation snapshot = collect_instrumentation();
+
+        // 回调在锁外执行，回调中可以再次汇总或增删回调
+        std::vector<instrumentation_exporter> exporters;
+        {
+            instrumentation_context::registry& r = instrumentation_context::shared();
+            std::lock_guard lock(r.mutex);
+            for(const auto& [id, exporter] : r.exporters)
+                exporters.push_back(exporter);
+        }
+
+        for(const instrumentation_exporter& exporter : exporters)
+            exporter(snapshot);
+    }
+
+
+
+#if defined(ALGAE_VINTEGER_INSTRUMENTATION)
+    thread_local __instrumentation_scope* instrumentation_context::current = nullptr;
+
+    __instrumentation_scope::__instrumentation_scope(const vinteger_operation operation, const std::size_t limbs)
+        :__operation(operation), __limbs(limbs), __start(instrumentation_context::now()), __parent(instrumentation_context::current)
+    {
+        instrumentation_context::current = this;
+    }
+
+    __instrumentation_scope::~__instrumentation_scope()
+    {
+        const std::uint64_t elapsed = std::uint64_t(std::max<std::int64_t>(instrumentation_context::now() - __start, 0));
+        instrumentation_context::current = __parent;
+
+        instrumentation_context::operation_counters& c = instrumentation_context::local().operations[std::size_t(__operation)];
+        c.calls.add(1);
+        c.limbs.add(__limbs);
+        c.nanoseconds.add(elapsed);
+        c.size_histogram[std::bit_width(__limbs)].add(1);
+        c.latency_histogram[std::bit_width(elapsed)].add(1);
+        if(__algorithm < vinteger_algorithm_count)
+            c.algorithms[__algorithm].add(1);
+    }
+
+    void __instrument_algorithm(const vinteger_algorithm algorithm)
+    {
+        if(instrumentation_context::current)
+            instrumentation_context::current->__algorithm = std::size_t(algorithm);
+    }
+
+    void __instrument_allocation(const std::size_t limbs)
+    {
+        instrumentation_context::thread_counters& c = instrumentation_context::local();
+        c.allocations.add(1);
+        c.allocated_limbs.add(limbs);
+    }
+
+    void __instrument_release() {
+        instrumentation_context::local().releases.add(1);
+    }
+#endif
+}
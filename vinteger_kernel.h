@@ -0,0 +1,112 @@
+#ifndef ALGAE_VINTEGER_KERNEL_H
+#define ALGAE_VINTEGER_KERNEL_H
+
+// 库内部共用的计算单元级内核，各源文件包含本头文件，使内层循环中的调用都能内联
+// 不属于公开接口，使用者只需包含 vinteger.h
+#include "vinteger.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace algae
+{
+    // 全加器函数，用于处理加法运算中的进位
+    // 参数 a 和 b 为要相加的两个 64 位无符号整数
+    // 参数 carry 为进位标志，引用传递
+    // 返回值：相加后的结果
+    inline vinteger::CUtype full_adder(vinteger::CUtype a, vinteger::CUtype b, bool& carry) 
+    {
+        // 计算相加结果
+        vinteger::CUtype c = a + b;
+        const bool overflow = c < a;
+        c += carry;
+        // 判断是否产生进位，两次相加至多只有一次会溢出
+        carry = overflow || (carry && c == 0);
+        return c;
+    }
+
+    // 全减器函数，用于处理减法运算中的借位
+    // 参数 a 和 b 为要相减的两个 64 位无符号整数
+    // 参数 retreat 为借位标志，引用传递
+    // 返回值：相减后的结果
+    inline vinteger::CUtype full_subtractor(vinteger::CUtype a, vinteger::CUtype b, bool& retreat)
+    {
+        // 计算相减结果
+        vinteger::CUtype diff = a - b - retreat;
+        // 判断是否产生借位
+        retreat = a < b || (a == b && retreat);
+        return diff;
+    }
+
+    // 处理进位
+    // 参数 x 为要处理的 64 位无符号整数
+    // 参数 carry 为进位标志，引用传递
+    // 返回值：处理后的结果
+    inline vinteger::CUtype carry_handle(vinteger::CUtype x, bool& carry) 
+    {
+        // 加上进位
+        vinteger::CUtype c = x + carry;
+        // 判断是否产生进位
+        carry = c < x && carry;
+        return c;
+    }
+
+    // 处理借位
+    // 参数 x 为要处理的 64 位无符号整数
+    // 参数 retreat 为借位标志，引用传递
+    // 返回值：处理后的结果
+    inline vinteger::CUtype retreat_handle(vinteger::CUtype x, bool& retreat)
+    {
+        // 减去借位
+        vinteger::CUtype diff = x - retreat;
+        // 判断是否产生借位
+        retreat = x == 0 && retreat;
+        return diff;
+    }
+
+    inline int __int_sign(const std::int64_t x) {
+        if(x > 0)
+            return 1;
+        
+        return x ? -1 : 0;
+    }
+
+    inline int __int_sign(const std::uint64_t x) {
+        return x ? 1 : 0;
+    }
+
+    inline std::int64_t __set_int_sign(const std::uint64_t x, int sign) {
+        return sign > 0 ? x : -((std::int64_t)x);
+    }
+
+    // 容纳 bit_count 个二进制位所需的 unit_size 位单元数
+    inline std::size_t bit_capacity(const std::size_t bit_count, const std::size_t unit_size) {
+        return bit_count / unit_size + bool(bit_count % unit_size);
+    }
+
+
+
+    // 以下为跨源文件调用的内部函数，只在此处声明一次
+
+    // 定义于 vinteger_thread_pool.cpp
+    // 策略实际使用的线程数，threads 为 0 时取硬件并发数
+    std::size_t __policy_threads(const exec_policy& policy);
+    // 在线程池中执行一组任务并等待全部完成
+    void __parallel_invoke(std::vector<std::function<void()>>& functions);
+
+    // 定义于 vinteger_divider.cpp
+    // 同时求商与余数，只做一次除法
+    void __divmod(const vinteger& a, const vinteger& b, vinteger& quotient, vinteger& remainder);
+
+    // 定义于 vinteger_combinatorics.cpp
+    // 不超过 n 的所有素数
+    std::vector<std::uint32_t> __prime_sieve(std::uint64_t n);
+
+    // 定义于 vinteger_cast_for_string.cpp
+    // x 的十进制表示（包括负号）长度的上界
+    std::size_t __decimal_width(const vinteger& x);
+    // 将 x 的十进制表示写入 out，返回写出的字符数
+    std::size_t __write_decimal(const vinteger& x, char* out, const exec_policy& policy);
+}
+
+#endif
@@ -0,0 +1,358 @@
+#include "vinteger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ALGAE_VINTEGER_MAPPED_FILE 1
+#endif
+
+namespace algae
+{
+    struct mapped_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        // 映射文件的内容是一条完整形式的序列化记录：16 字节头部之后是小端序的计算单元
+        // 映射起点按页对齐，因此计算单元按 8 字节对齐，可以直接借用为 vinteger_view
+        constexpr static std::size_t header_size = 16;
+
+        // 分块乘法中驻留内存的计算单元数约为块长的 6 倍：两个输入块、2 倍块长的乘积与乘法的临时空间
+        constexpr static std::size_t block_working_set = 6;
+        constexpr static std::size_t min_block_units = 32;
+
+        [[noreturn]] static void fail(const char* operation) {
+            throw std::system_error(errno, std::generic_category(), operation);
+        }
+
+        static std::size_t file_size(const std::size_t length) {
+            return header_size + length * sizeof(__CUtype);
+        }
+
+        static void write_header(unsigned char* base, const int sign, const std::uint64_t bit_length)
+        {
+            // 与 serialize(x, false) 的头部相同：版本 1，标志只含负号
+            std::memset(base, 0, header_size);
+            base[0] = 1;
+            base[1] = sign < 0 ? 1 : 0;
+            for(std::size_t i = 0; i < 8; ++i)
+                base[8 + i] = (unsigned char)(bit_length >> (8 * i));
+        }
+
+        static const __CUtype* units(const vinteger& x) {
+            return x.__buffer;
+        }
+
+        static std::size_t length(const vinteger& x) {
+            return x.__value_length();
+        }
+
+        // r[0, n) += a[0, an)，向高位传播进位，返回移出 r 的进位
+        static bool add_into(__CUtype* r, const std::size_t n, const __CUtype* a, const std::size_t an)
+        {
+            bool carry = false;
+            std::size_t i = 0;
+            for(; i < an; ++i)
+            {
+                const __CUtype sum = r[i] + a[i];
+                const bool overflow = sum < r[i];
+                r[i] = sum + carry;
+                carry = overflow || r[i] < sum;
+            }
+
+            for(; carry && i < n; ++i)
+                carry = ++r[i] == 0;
+
+            return carry;
+        }
+    };
+
+
+
+    mapped_vinteger::mapped_vinteger(const vinteger& x, const storage_policy& storage)
+    {
+        const std::size_t length = mapped_context::length(x);
+        __create(storage, length);
+
+        if(length)
+            std::memcpy(__data() + mapped_context::header_size, mapped_context::units(x), length * sizeof(std::uint64_t));
+
+        __finish(x.sign(), x.value_bit_width());
+    }
+
+    mapped_vinteger::mapped_vinteger(mapped_vinteger&& source) {
+        *this = std::move(source);
+    }
+
+    mapped_vinteger& mapped_vinteger::operator=(mapped_vinteger&& source)
+    {
+        if(this == &source)
+            return *this;
+
+        __close();
+        std::swap(__path, source.__path);
+        std::swap(__mapping, source.__mapping);
+        std::swap(__mapping_size, source.__mapping_size);
+        std::swap(__temporary, source.__temporary);
+
+        // 映射地址不随对象移动，视图可以直接转移
+        __view = source.__view;
+        source.__view = vinteger_view();
+        return *this;
+    }
+
+    mapped_vinteger::~mapped_vinteger() {
+        __close();
+    }
+
+    unsigned char* mapped_vinteger::__data() const {
+        return static_cast<unsigned char*>(__mapping);
+    }
+
+#if defined(ALGAE_VINTEGER_MAPPED_FILE)
+    void mapped_vinteger::__map(const int fd, const std::size_t size, const bool writable)
+    {
+        __mapping_size = size;
+        __mapping = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if(__mapping == MAP_FAILED)
+        {
+            __mapping = nullptr;
+            mapped_context::fail("mmap");
+        }
+    }
+
+    void mapped_vinteger::__create(const storage_policy& storage, const std::size_t length)
+    {
+        const std::filesystem::path directory = storage.scratch_directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(storage.scratch_directory);
+        std::string name = (directory / "vinteger-XXXXXX").string();
+
+        const int fd = ::mkstemp(name.data());
+        if(fd < 0)
+            mapped_context::fail("mkstemp");
+
+        __path = name;
+        __temporary = true;
+
+        const std::size_t size = mapped_context::file_size(length);
+        if(::ftruncate(fd, off_t(size)) != 0)
+        {
+            ::close(fd);
+            mapped_context::fail("ftruncate");
+        }
+
+        try
+        {
+            __map(fd, size, true);
+        }
+        catch(...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        // 映射建立后不再需要文件描述符
+        ::close(fd);
+    }
+
+    mapped_vinteger mapped_vinteger::open(const std::string& path)
+    {
+        mapped_vinteger result;
+
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            mapped_context::fail("open");
+
+        struct stat status;
+        if(::fstat(fd, &status) != 0)
+        {
+            ::close(fd);
+            mapped_context::fail("fstat");
+        }
+
+        if(std::size_t(status.st_size) < mapped_context::header_size)
+        {
+            ::close(fd);
+            throw std::invalid_argument("mapped file is not a serialized record");
+        }
+
+        try
+        {
+            result.__map(fd, std::size_t(status.st_size), false);
+        }
+        catch(...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        ::close(fd);
+        result.__path = path;
+
+        const serialized_record record = peek_record(std::span<const std::byte>(reinterpret_cast<const std::byte*>(result.__mapping), result.__mapping_size));
+        if(record.limb_bytes.empty() && record.sign != 0)
+            throw std::invalid_argument("mapped file must hold a full-form record");
+
+        result.__view = vinteger_view(record);
+        return result;
+    }
+
+    void mapped_vinteger::__close()
+    {
+        __view = vinteger_view();
+
+        if(__mapping)
+            ::munmap(__mapping, __mapping_size);
+
+        if(__temporary && !__path.empty())
+            ::unlink(__path.c_str());
+
+        __mapping = nullptr;
+        __mapping_size = 0;
+        __temporary = false;
+        __path.clear();
+    }
+
+    void mapped_vinteger::persist(const std::string& path)
+    {
+        if(!__mapping)
+            throw std::runtime_error("mapped integer is empty");
+
+        if(::msync(__mapping, __mapping_size, MS_SYNC) != 0)
+            mapped_context::fail("msync");
+
+        // 乘积文件按 an + bn 个计算单元创建，最高的计算单元可能为 0，保存时截去
+        if(::truncate(__path.c_str(), off_t(mapped_context::file_size(__view.limbs().size()))) != 0)
+            mapped_context::fail("truncate");
+
+        if(path != __path)
+        {
+            std::error_code error;
+            std::filesystem::rename(__path, path, error);
+
+            // 临时目录与目标位于不同文件系统时无法改名，改为复制后删除原文件
+            // 映射仍指向原文件，其内容在解除映射前保持有效，且与复制出的文件相同
+            if(error == std::errc::cross_device_link)
+            {
+                try
+                {
+                    std::filesystem::copy_file(__path, path, std::filesystem::copy_options::overwrite_existing);
+                }
+                catch(...)
+                {
+                    std::filesystem::remove(path, error);
+                    throw;
+                }
+
+                std::filesystem::remove(__path);
+            }
+            else if(error)
+                throw std::filesystem::filesystem_error("rename", __path, path, error);
+
+            __path = path;
+        }
+
+        __temporary = false;
+    }
+#else
+    void mapped_vinteger::__map(int, std::size_t, bool) {
+        throw std::runtime_error("memory mapped storage is not supported on this platform");
+    }
+
+    void mapped_vinteger::__create(const storage_policy&, std::size_t) {
+        throw std::runtime_error("memory mapped storage is not supported on this platform");
+    }
+
+    mapped_vinteger mapped_vinteger::open(const std::string&) {
+        throw std::runtime_error("memory mapped storage is not supported on this platform");
+    }
+
+    void mapped_vinteger::__close() {
+        __view = vinteger_view();
+    }
+
+    void mapped_vinteger::persist(const std::string&) {
+        throw std::runtime_error("memory mapped storage is not supported on this platform");
+    }
+#endif
+
+    // 写入头部，并按实际长度重新借用计算单元
+    void mapped_vinteger::__finish(const int sign, const std::uint64_t bit_length)
+    {
+        mapped_context::write_header(__data(), sign, bit_length);
+
+        const std::size_t length = (bit_length + mapped_context::__CUtype_bit_length - 1) / mapped_context::__CUtype_bit_length;
+        __view = vinteger_view(std::span<const std::uint64_t>(reinterpret_cast<const std::uint64_t*>(__data() + mapped_context::header_size), length), sign);
+    }
+
+    const vinteger_view& mapped_vinteger::view() const {
+        return __view;
+    }
+
+    mapped_vinteger::operator const vinteger&() const {
+        return __view;
+    }
+
+    vinteger mapped_vinteger::load() const {
+        return __view.value();
+    }
+
+    const std::string& mapped_vinteger::path() const {
+        return __path;
+    }
+
+
+
+    mapped_vinteger mapped_mul(const vinteger& a, const vinteger& b, const storage_policy& storage)
+    {
+        const std::size_t an = mapped_context::length(a), bn = mapped_context::length(b);
+
+        mapped_vinteger result;
+        result.__create(storage, an + bn);
+
+        if(an == 0 || bn == 0)
+        {
+            result.__finish(0, 0);
+            return result;
+        }
+
+        std::uint64_t* r = reinterpret_cast<std::uint64_t*>(result.__data() + mapped_context::header_size);
+
+        // 按内存预算决定块长；两个操作数都不超过一块时退化为一次内存中的乘法
+        const std::size_t block = std::max(storage.memory_budget / (mapped_context::block_working_set * sizeof(std::uint64_t)), mapped_context::min_block_units);
+        const std::size_t a_blocks = (an + block - 1) / block, b_blocks = (bn + block - 1) / block;
+
+        // 按输出的对角线 k = i + j 依次处理块对，写入位置随 k 单调推进，已完成的低位部分不再被访问
+        // 输入块以视图借用（可以是映射文件），每次只有一个块乘积驻留在内存中
+        for(std::size_t k = 0; k + 1 < a_blocks + b_blocks; ++k)
+        {
+            for(std::size_t i = k < b_blocks ? 0 : k - b_blocks + 1; i <= std::min(k, a_blocks - 1); ++i)
+            {
+                const std::size_t j = k - i;
+                const std::size_t a_length = std::min(block, an - i * block), b_length = std::min(block, bn - j * block);
+
+                const vinteger_view a_block(std::span<const std::uint64_t>(mapped_context::units(a) + i * block, a_length));
+                const vinteger_view b_block(std::span<const std::uint64_t>(mapped_context::units(b) + j * block, b_length));
+                const vinteger product = mul(a_block, b_block, storage.policy);
+
+                const std::size_t offset = k * block;
+                mapped_context::add_into(r + offset, an + bn - offset, mapped_context::units(product), mapped_context::length(product));
+            }
+        }
+
+        std::size_t length = an + bn;
+        while(length > 0 && r[length - 1] == 0)
+            --length;
+
+        result.__finish(a.sign() * b.sign(), (length - 1) * mapped_context::__CUtype_bit_length + std::bit_width(r[length - 1]));
+        return result;
+    }
+}
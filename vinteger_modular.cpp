@@ -0,0 +1,264 @@
+#include "vinteger.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace algae
+{
+    // 计算奇数 x 在模 2^64 下的逆元
+    // 以 x 自身作为初值（对 8 取模时已正确），每次牛顿迭代使正确的位数翻倍
+    static vinteger::CUtype __unit_inverse(const vinteger::CUtype x)
+    {
+        vinteger::CUtype inverse = x;
+
+        for(int i = 0; i < 5; ++i)
+            inverse *= 2 - x * inverse;
+
+        return inverse;
+    }
+
+    mod_context::mod_context(const vinteger& modulus)
+        : __modulus(modulus)
+    {
+        if(modulus.sign() <= 0)
+            throw std::invalid_argument("modulus is not positive");
+
+        __length = __modulus.__value_length();
+        __montgomery = __modulus.__buffer[0] & 1;
+
+        if(__montgomery)
+        {
+            __inverse = -__unit_inverse(__modulus.__buffer[0]);
+            __r_square = (vinteger(1) << (2 * __length * __CUtype_bit_length)) % __modulus;
+            __one = __montgomery_multiply(__r_square, vinteger(1));
+        }
+        else
+        {
+            const std::size_t k = __modulus.value_bit_width();
+            __reciprocal = (vinteger(1) << (2 * k)) / __modulus;
+            __one = vinteger(1) % __modulus;
+        }
+    }
+
+    const vinteger& mod_context::modulus() const {
+        return __modulus;
+    }
+
+    bool mod_context::montgomery() const {
+        return __montgomery;
+    }
+
+    // Montgomery 乘法（CIOS），计算 a * b * R^-1 mod modulus
+    // a 与 b 须位于 [0, modulus) 中，逐个计算单元交替进行乘法与约简，全程没有除法
+    vinteger mod_context::__montgomery_multiply(const vinteger& a, const vinteger& b) const
+    {
+        const std::size_t n = __length;
+        const std::size_t a_length = a.__value_length(), b_length = b.__value_length();
+        const __CUtype* m = __modulus.__buffer;
+
+        vinteger result;
+        result.__change_capacity(n + 2, false, true);
+        __CUtype* t = result.__buffer;
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            __CUtype carry = 0, high = 0;
+
+            // t += a[i] * b
+            if(const __CUtype ai = i < a_length ? a.__buffer[i] : 0; ai)
+            {
+                std::size_t j = 0;
+                for(; j < b_length; ++j)
+                {
+                    __CUtype low = vinteger::__multiply_unit(ai, b.__buffer[j], high);
+                    low += t[j], high += low < t[j];
+                    low += carry, high += low < carry;
+                    t[j] = low, carry = high;
+                }
+
+                for(; carry && j < n + 2; ++j)
+                    t[j] += carry, carry = t[j] < carry;
+            }
+
+            // t += u * m，使 t 的最低计算单元为 0
+            const __CUtype u = t[0] * __inverse;
+            carry = 0;
+
+            std::size_t j = 0;
+            for(; j < n; ++j)
+            {
+                __CUtype low = vinteger::__multiply_unit(u, m[j], high);
+                low += t[j], high += low < t[j];
+                low += carry, high += low < carry;
+                t[j] = low, carry = high;
+            }
+
+            for(; carry && j < n + 2; ++j)
+                t[j] += carry, carry = t[j] < carry;
+
+            // t /= 2^64
+            std::memmove(t, t + 1, (n + 1) * sizeof(__CUtype));
+            t[n + 1] = 0;
+        }
+
+        // 此时 t < 2 * modulus，最多需要一次减法
+        bool greater_equal = t[n] != 0;
+        if(!greater_equal)
+        {
+            greater_equal = true;
+            for(std::size_t j = n; j-- > 0; )
+            {
+                if(t[j] != m[j])
+                {
+                    greater_equal = t[j] > m[j];
+                    break;
+                }
+            }
+        }
+
+        if(greater_equal)
+        {
+            bool retreat = false;
+            for(std::size_t j = 0; j <= n; ++j)
+            {
+                const __CUtype subtrahend = j < n ? m[j] : 0;
+                const __CUtype diff = t[j] - subtrahend - retreat;
+                retreat = t[j] < subtrahend || (t[j] == subtrahend && retreat);
+                t[j] = diff;
+            }
+        }
+
+        result.__refresh_bit_length(n + 1);
+        return result;
+    }
+
+    // Barrett 约简，x 须位于 [0, modulus^2) 中
+    // q = ((x >> (k - 1)) * reciprocal) >> (k + 1) 与真实商的误差不超过 2
+    vinteger mod_context::__barrett_reduce(const vinteger& x) const
+    {
+        if(x < __modulus)
+            return x;
+
+        const std::size_t k = __modulus.value_bit_width();
+        vinteger q = ((x >> (k - 1)) * __reciprocal) >> (k + 1);
+        vinteger r = x - q * __modulus;
+
+        while(r >= __modulus)
+            r -= __modulus;
+
+        return r;
+    }
+
+    // 将任意整数约简到 [0, modulus) 中
+    vinteger mod_context::__normalize(const vinteger& x) const
+    {
+        if(x.sign() >= 0 && x < __modulus)
+            return x;
+
+        vinteger r = (x.sign() < 0 ? -x : x) % __modulus;
+        if(x.sign() < 0 && !r.empty())
+            r = __modulus - r;
+
+        return r;
+    }
+
+
+
+    vinteger mod_context::to_domain(const vinteger& x) const
+    {
+        if(!__montgomery)
+            return __normalize(x);
+
+        return __montgomery_multiply(__normalize(x), __r_square);
+    }
+
+    vinteger mod_context::from_domain(const vinteger& x) const
+    {
+        if(!__montgomery)
+            return x;
+
+        return __montgomery_multiply(x, vinteger(1));
+    }
+
+    vinteger mod_context::one() const {
+        return __one;
+    }
+
+
+
+    vinteger mod_context::mul(const vinteger& a, const vinteger& b) const
+    {
+        if(__montgomery)
+            return __montgomery_multiply(a, b);
+
+        return __barrett_reduce(a * b);
+    }
+
+    vinteger mod_context::sqr(const vinteger& a) const {
+        return mul(a, a);
+    }
+
+    vinteger mod_context::add(const vinteger& a, const vinteger& b) const
+    {
+        vinteger r = a + b;
+        if(r >= __modulus)
+            r -= __modulus;
+
+        return r;
+    }
+
+    vinteger mod_context::sub(const vinteger& a, const vinteger& b) const
+    {
+        vinteger r = a - b;
+        if(r.sign() < 0)
+            r += __modulus;
+
+        return r;
+    }
+
+    // 固定 4 位窗口的快速幂，a 与结果均处于约简域中
+    vinteger mod_context::pow(const vinteger& a, const vinteger& exponent) const
+    {
+        if(exponent.sign() < 0)
+            throw std::invalid_argument("exponent is negative");
+
+        if(exponent.empty())
+            return __one;
+
+        constexpr std::size_t window = 4;
+
+        vinteger table[1 << window];
+        table[0] = __one;
+        table[1] = a;
+        for(std::size_t i = 2; i < (1 << window); ++i)
+            table[i] = mul(table[i - 1], a);
+
+        const std::size_t bit_width = exponent.value_bit_width();
+        auto window_value = [&](std::size_t index)
+        {
+            std::size_t value = 0;
+            for(std::size_t i = 0; i < window; ++i)
+            {
+                const std::size_t bit = index + i;
+                if(bit < bit_width && (exponent.__buffer[bit / __CUtype_bit_length] >> (bit % __CUtype_bit_length) & 1))
+                    value |= std::size_t(1) << i;
+            }
+            return value;
+        };
+
+        std::size_t index = (bit_width - 1) / window * window;
+        vinteger result = table[window_value(index)];
+
+        while(index > 0)
+        {
+            index -= window;
+
+            for(std::size_t i = 0; i < window; ++i)
+                result = sqr(result);
+
+            if(const std::size_t value = window_value(index); value)
+                result = mul(result, table[value]);
+        }
+
+        return result;
+    }
+}
@@ -1,126 +1,388 @@
-#include "vinteger.h"
-
-namespace algae
-{
-    extern std::int64_t __set_int_sign(const std::uint64_t x, int sign);
-    extern std::size_t bit_capacity(const std::size_t bit_count, const std::size_t unit_size);
-    extern vinteger::CUtype full_adder(vinteger::CUtype a, vinteger::CUtype b, bool& carry);
-    extern vinteger::CUtype carry_handle(vinteger::CUtype x, bool& carry);
-
-
-    struct multiplier_context
-    {
-        using __CUtype = vinteger::__CUtype;
-        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
-
-        const vinteger * vint_max = nullptr;
-        const vinteger * vint_min = nullptr;
-
-        vinteger * output = nullptr;
-        int sign = 0;
-
-        bool pretreatment(const vinteger& x, const vinteger& y, vinteger& z) 
-        {
-            if(x.empty() || y.empty())
-                z.clear();
-            else if(x.value_bit_width() == 1)
-                z = x.sign() == y.sign() ? y : -y;
-            else if(y.value_bit_width() == 1)
-                z = x.sign() == y.sign() ? x : -x;
-            else if(x.value_bit_width() > 32 || y.value_bit_width() > 32)
-                return false;
-            else
-            {
-                z.__change_capacity(1);
-                z.__buffer[0] = x.__buffer[0] * y.__buffer[0];
-                z.__bit_length = __set_int_sign(std::bit_width(z.__buffer[0]), x.sign() * y.sign());
-            }
-
-            return true;
-        }
-
-        multiplier_context(const vinteger& x, const vinteger& y, vinteger& z)
-        {
-            if(pretreatment(x, y, z))
-                return;
-            
-            sign = x.sign() * y.sign();
-            output = &z;
-
-            if (x >= y)
-                vint_max = &x, vint_min = &y;
-            else
-                vint_max = &y, vint_min = &x;
-
-            naive_multiplication();
-        }
-
-
-
-        inline bool bitget(const __CUtype* buffer, const int i) const {
-            return buffer[i / __CUtype_bit_length] & (1ull << __CUtype(i % __CUtype_bit_length));
-        }
-
-        std::size_t shift_plus(const int shift) 
-        {
-            const std::size_t length = vint_max->__value_length();
-            const std::size_t shift_unit = shift / __CUtype_bit_length;
-            const std::size_t shift_bit = shift % __CUtype_bit_length;
-
-            __CUtype overflow = 0, index = 0;
-            bool carry = false;
-            
-            for(; index < length; ++index)
-            {
-                const __CUtype temporary = vint_max->__buffer[index], shift_index = index + shift_unit;
-                output->__buffer[shift_index] = full_adder(output->__buffer[shift_index], overflow | (temporary << shift_bit), carry);
-                overflow = temporary >> (__CUtype_bit_length - shift_bit);
-            }
-            
-            if(overflow)
-            {
-                output->__buffer[index + shift_unit] = full_adder(output->__buffer[index + shift_unit], overflow, carry);
-                ++index;
-            }
-
-            for(; carry; ++index)
-            {
-                const __CUtype shift_index = index + shift_unit;
-                output->__buffer[shift_index] = carry_handle(output->__buffer[shift_index], carry);
-            }
-
-            return index + shift_unit - 1;
-        }
-
-        void naive_multiplication()
-        {
-            std::size_t highest_order = 0;
-
-            for(int i = vint_min->value_bit_width() - 1; i >= 0; --i)
-            {
-                if(!bitget(vint_min->__buffer, i))
-                    continue;
-                
-                if(output->__capacity == 0)
-                    output->__change_capacity(bit_capacity(vint_min->value_bit_width() + vint_max->value_bit_width(), __CUtype_bit_length) + 1, false, true);
-
-                highest_order = std::max(highest_order, shift_plus(i));
-            }
-
-            output->__bit_length = __set_int_sign(std::bit_width(output->__buffer[highest_order]) + highest_order * __CUtype_bit_length, sign);
-        }
-    };
-
-    vinteger& vinteger::operator*=(const vinteger& other) 
-    {
-        *this = *this * other;
-        return *this;
-    }
-
-    vinteger operator*(const vinteger& a, const vinteger& b) 
-    {
-        vinteger c;
-        multiplier_context(a, b, c);
-        return c;
-    }
+#include "vinteger_kernel.h"
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace algae
+{
+    struct multiplier_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        const vinteger * vint_max = nullptr;
+        const vinteger * vint_min = nullptr;
+
+        vinteger * output = nullptr;
+        int sign = 0;
+
+        bool pretreatment(const vinteger& x, const vinteger& y, vinteger& z) 
+        {
+            if(x.empty() || y.empty())
+                z.clear();
+            else if(x.value_bit_width() == 1)
+                z = x.sign() > 0 ? y : -y;
+            else if(y.value_bit_width() == 1)
+                z = y.sign() > 0 ? x : -x;
+            else if(x.value_bit_width() > 32 || y.value_bit_width() > 32)
+                return false;
+            else
+            {
+                z.__change_capacity(1);
+                z.__buffer[0] = x.__buffer[0] * y.__buffer[0];
+                z.__bit_length = __set_int_sign(std::bit_width(z.__buffer[0]), x.sign() * y.sign());
+            }
+
+            return true;
+        }
+
+        // 计算单元长度低于该值时使用逐字的基本乘法，见 vinteger_thresholds::karatsuba
+        static std::size_t karatsuba_threshold() {
+            return thresholds().karatsuba;
+        }
+
+        multiplier_context() = default;
+
+        multiplier_context(const vinteger& x, const vinteger& y, vinteger& z, const exec_policy& policy = {1})
+        {
+            ALGAE_VINTEGER_INSTRUMENT(multiply, x.__value_length() + y.__value_length());
+
+            // 0 与单计算单元的平凡情形不计入算法统计
+            if(pretreatment(x, y, z))
+                return;
+            
+            sign = x.sign() * y.sign();
+            output = &z;
+
+            // 只需按计算单元长度区分长短操作数，不必比较数值大小
+            if(x.__value_length() >= y.__value_length())
+                vint_max = &x, vint_min = &y;
+            else
+                vint_max = &y, vint_min = &x;
+
+            ALGAE_VINTEGER_INSTRUMENT_ALGORITHM(vint_min->__value_length() < karatsuba_threshold() ? vinteger_algorithm::basecase : vinteger_algorithm::karatsuba);
+
+            limb_multiplication(__policy_threads(policy), std::max<std::size_t>(policy.grain, karatsuba_threshold()));
+        }
+
+
+
+        // r[0, n) = a + b，返回进位
+        static __CUtype add_n(__CUtype* r, const __CUtype* a, const __CUtype* b, const std::size_t n)
+        {
+            bool carry = false;
+            for(std::size_t i = 0; i < n; ++i)
+                r[i] = full_adder(a[i], b[i], carry);
+
+            return carry;
+        }
+
+        // r[0, n) = a - b，返回借位
+        static __CUtype sub_n(__CUtype* r, const __CUtype* a, const __CUtype* b, const std::size_t n)
+        {
+            bool retreat = false;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                const __CUtype diff = a[i] - b[i] - retreat;
+                retreat = a[i] < b[i] || (a[i] == b[i] && retreat);
+                r[i] = diff;
+            }
+
+            return retreat;
+        }
+
+        // r[0, rn) += a[0, an)，an <= rn，返回最高位之外的进位
+        static __CUtype add_in(__CUtype* r, const std::size_t rn, const __CUtype* a, const std::size_t an)
+        {
+            bool carry = false;
+            std::size_t i = 0;
+            for(; i < an; ++i)
+                r[i] = full_adder(r[i], a[i], carry);
+
+            for(; carry && i < rn; ++i)
+                r[i] = carry_handle(r[i], carry);
+
+            return carry;
+        }
+
+        // r[0, rn) -= a[0, an)，an <= rn，返回借位
+        static __CUtype sub_in(__CUtype* r, const std::size_t rn, const __CUtype* a, const std::size_t an)
+        {
+            bool retreat = sub_n(r, r, a, an);
+            for(std::size_t i = an; retreat && i < rn; ++i)
+                retreat = r[i]-- == 0;
+
+            return retreat;
+        }
+
+        // |a - b|，两者长度均为 n，a >= b 时返回 1，否则返回 -1
+        static int abs_sub(__CUtype* r, const __CUtype* a, const __CUtype* b, const std::size_t n)
+        {
+            for(std::size_t i = n; i-- > 0; )
+            {
+                if(a[i] != b[i])
+                {
+                    if(a[i] > b[i])
+                        return sub_n(r, a, b, n), 1;
+
+                    return sub_n(r, b, a, n), -1;
+                }
+            }
+
+            std::memset(r, 0, n * sizeof(__CUtype));
+            return 1;
+        }
+
+        // 逐字的基本乘法（schoolbook），r 的长度为 an + bn
+        static void basecase(const __CUtype* a, const std::size_t an, const __CUtype* b, const std::size_t bn, __CUtype* r)
+        {
+            std::memset(r, 0, (an + bn) * sizeof(__CUtype));
+
+            for(std::size_t i = 0; i < bn; ++i)
+            {
+                __CUtype carry = 0, high = 0;
+                if(b[i] == 0)
+                    continue;
+
+                for(std::size_t j = 0; j < an; ++j)
+                {
+                    __CUtype low = vinteger::__multiply_unit(a[j], b[i], high);
+                    low += r[i + j], high += low < r[i + j];
+                    low += carry, high += low < carry;
+                    r[i + j] = low, carry = high;
+                }
+
+                r[i + an] = carry;
+            }
+        }
+
+        // Karatsuba 递归所需的临时空间
+        static std::size_t karatsuba_scratch(const std::size_t n)
+        {
+            if(n < karatsuba_threshold())
+                return 0;
+
+            const std::size_t h = n - n / 2;
+            return 6 * h + 1 + karatsuba_scratch(h);
+        }
+
+        // Karatsuba 乘法，a 与 b 的长度均为 n，r 的长度为 2n
+        // 记 a = a0 + a1 * B^m，b = b0 + b1 * B^m，则 a0 * b1 + a1 * b0 = z0 + z2 - (a1 - a0) * (b1 - b0)
+        // 三个子乘积相互独立，threads 大于 1 且规模不小于 grain 时作为任务交给线程池，各自使用独立的临时空间
+        static void karatsuba(const __CUtype* a, const __CUtype* b, const std::size_t n, __CUtype* r, __CUtype* scratch, const std::size_t threads, const std::size_t grain)
+        {
+            if(n < karatsuba_threshold())
+                return basecase(a, n, b, n, r);
+
+            const std::size_t m = n / 2, h = n - m;
+
+            // 低位部分补 0 到长度 h，再求 |a1 - a0| 与 |b1 - b0|
+            __CUtype* da = scratch;
+            __CUtype* db = scratch + h;
+            __CUtype* t = scratch + 2 * h;
+            __CUtype* w = scratch + 4 * h;
+            __CUtype* rest = scratch + 6 * h + 1;
+
+            std::memcpy(w, a, m * sizeof(__CUtype)), w[m] = 0;
+            std::memcpy(w + h, b, m * sizeof(__CUtype)), w[h + m] = 0;
+            const int sign = abs_sub(da, a + m, w, h) * abs_sub(db, b + m, w + h, h);
+
+            if(threads > 1 && n >= grain)
+            {
+                // threads 个线程的预算按子任务均分；只有两个线程时，先并行求 z0 与 z2，再求中间项
+                const std::size_t task_count = threads >= 3 ? 3 : 2;
+                std::vector<std::vector<__CUtype>> scratches(task_count, std::vector<__CUtype>(karatsuba_scratch(h)));
+                auto budget = [&](std::size_t i) { return threads / task_count + (i < threads % task_count); };
+
+                std::vector<std::function<void()>> tasks;
+                tasks.emplace_back([&] { karatsuba(a, b, m, r, scratches[0].data(), budget(0), grain); });
+                tasks.emplace_back([&] { karatsuba(a + m, b + m, h, r + 2 * m, scratches[1].data(), budget(1), grain); });
+                if(task_count == 3)
+                    tasks.emplace_back([&] { karatsuba(da, db, h, t, scratches[2].data(), budget(2), grain); });
+
+                __parallel_invoke(tasks);
+
+                if(task_count == 2)
+                    karatsuba(da, db, h, t, rest, 1, grain);
+            }
+            else
+            {
+                karatsuba(a, b, m, r, rest, 1, grain);
+                karatsuba(a + m, b + m, h, r + 2 * m, rest, 1, grain);
+                karatsuba(da, db, h, t, rest, 1, grain);
+            }
+
+            // w = z0 + z2 - sign * t，长度为 2h + 1
+            std::memcpy(w, r + 2 * m, 2 * h * sizeof(__CUtype)), w[2 * h] = 0;
+            add_in(w, 2 * h + 1, r, 2 * m);
+            if(sign > 0)
+                sub_in(w, 2 * h + 1, t, 2 * h);
+            else
+                add_in(w, 2 * h + 1, t, 2 * h);
+
+            add_in(r + m, 2 * n - m, w, std::min(2 * h + 1, 2 * n - m));
+        }
+
+        // 一般情形的乘法，an >= bn，r 的长度为 an + bn
+        // 长度悬殊时将 a 按 bn 分块：偶数块的乘积互不重叠，直接写入 r；奇数块写入临时空间后再统一加回
+        static void multiply(const __CUtype* a, const std::size_t an, const __CUtype* b, const std::size_t bn, __CUtype* r, const std::size_t threads, const std::size_t grain)
+        {
+            if(bn < karatsuba_threshold())
+                return basecase(a, an, b, bn, r);
+
+            if(an == bn)
+            {
+                std::vector<__CUtype> scratch(karatsuba_scratch(an));
+                return karatsuba(a, b, an, r, scratch.data(), threads, grain);
+            }
+
+            const std::size_t blocks = (an + bn - 1) / bn;
+            std::vector<__CUtype> odd(an + bn, 0);
+            std::memset(r, 0, (an + bn) * sizeof(__CUtype));
+
+            auto block = [&](const std::size_t i, const std::size_t budget)
+            {
+                const std::size_t offset = i * bn, length = std::min(bn, an - offset);
+                __CUtype* target = (i % 2 ? odd.data() : r) + offset;
+
+                if(length == bn)
+                    multiply(a + offset, bn, b, bn, target, budget, grain);
+                else
+                    multiply(b, bn, a + offset, length, target, budget, grain);
+            };
+
+            if(threads > 1 && bn >= grain)
+            {
+                // 块数不多于线程数时每块分得若干线程，否则每个任务串行处理一段连续的块
+                const std::size_t task_count = std::min(blocks, threads);
+                std::vector<std::function<void()>> tasks;
+
+                for(std::size_t k = 0; k < task_count; ++k)
+                {
+                    tasks.emplace_back([&, k]
+                    {
+                        const std::size_t budget = blocks < threads ? threads / blocks + (k < threads % blocks) : 1;
+                        for(std::size_t i = k; i < blocks; i += task_count)
+                            block(i, budget);
+                    });
+                }
+
+                __parallel_invoke(tasks);
+            }
+            else
+            {
+                for(std::size_t i = 0; i < blocks; ++i)
+                    block(i, 1);
+            }
+
+            if(blocks > 1)
+                add_in(r + bn, an, odd.data() + bn, an);
+        }
+
+        void limb_multiplication(const std::size_t threads, const std::size_t grain)
+        {
+            // 构造时已保证 vint_max 不短于 vint_min
+            const vinteger* x = vint_max;
+            const vinteger* y = vint_min;
+            const std::size_t an = x->__value_length(), bn = y->__value_length();
+
+            // 输出可能与操作数共用存储，先写入新的缓冲区
+            vinteger result;
+            result.__change_capacity(an + bn);
+            multiply(x->__buffer, an, y->__buffer, bn, result.__buffer, threads, grain);
+            result.__refresh_bit_length(an + bn, sign);
+
+            *output = std::move(result);
+        }
+
+
+
+        inline bool bitget(const __CUtype* buffer, const std::size_t i) const {
+            return buffer[i / __CUtype_bit_length] & (1ull << __CUtype(i % __CUtype_bit_length));
+        }
+
+        std::size_t shift_plus(const std::size_t shift) 
+        {
+            const std::size_t length = vint_max->__value_length();
+            const std::size_t shift_unit = shift / __CUtype_bit_length;
+            const std::size_t shift_bit = shift % __CUtype_bit_length;
+
+            __CUtype overflow = 0, index = 0;
+            bool carry = false;
+            
+            for(; index < length; ++index)
+            {
+                const __CUtype temporary = vint_max->__buffer[index], shift_index = index + shift_unit;
+                output->__buffer[shift_index] = full_adder(output->__buffer[shift_index], overflow | (temporary << shift_bit), carry);
+                overflow = shift_bit ? temporary >> (__CUtype_bit_length - shift_bit) : 0;
+            }
+            
+            if(overflow)
+            {
+                output->__buffer[index + shift_unit] = full_adder(output->__buffer[index + shift_unit], overflow, carry);
+                ++index;
+            }
+
+            for(; carry; ++index)
+            {
+                const __CUtype shift_index = index + shift_unit;
+                output->__buffer[shift_index] = carry_handle(output->__buffer[shift_index], carry);
+            }
+
+            return index + shift_unit - 1;
+        }
+
+        void naive_multiplication()
+        {
+            std::size_t highest_order = 0;
+
+            for(std::int64_t i = std::int64_t(vint_min->value_bit_width()) - 1; i >= 0; --i)
+            {
+                if(!bitget(vint_min->__buffer, i))
+                    continue;
+                
+                if(output->__capacity == 0)
+                    output->__change_capacity(bit_capacity(vint_min->value_bit_width() + vint_max->value_bit_width(), __CUtype_bit_length) + 1, false, true);
+
+                highest_order = std::max(highest_order, shift_plus(i));
+            }
+
+            output->__bit_length = __set_int_sign(std::bit_width(output->__buffer[highest_order]) + highest_order * __CUtype_bit_length, sign);
+        }
+    };
+
+    vinteger& vinteger::operator*=(const vinteger& other) 
+    {
+        *this = *this * other;
+        return *this;
+    }
+
+    vinteger operator*(const vinteger& a, const vinteger& b) 
+    {
+        vinteger c;
+        multiplier_context(a, b, c);
+        return c;
+    }
+
+    vinteger mul(const vinteger& a, const vinteger& b, const exec_policy& policy)
+    {
+        vinteger c;
+        multiplier_context(a, b, c, policy);
+        return c;
+    }
+
+    // 逐位移位相加的基准实现，仅供测试对拍使用
+    vinteger __naive_multiply(const vinteger& a, const vinteger& b)
+    {
+        vinteger c;
+        multiplier_context context;
+        if(context.pretreatment(a, b, c))
+            return c;
+
+        context.sign = a.sign() * b.sign();
+        context.output = &c;
+        context.vint_max = &a, context.vint_min = &b;
+        context.naive_multiplication();
+        return c;
+    }
 }
\ No newline at end of file
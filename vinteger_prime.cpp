@@ -0,0 +1,367 @@
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace algae
+{
+    struct prime_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        // 试除使用的素数上界，以及 next_prime 筛窗口使用的素数上界与窗口大小
+        constexpr static std::uint32_t trial_bound = 2000;
+        constexpr static std::uint32_t sieve_bound = 1 << 15;
+        constexpr static std::size_t sieve_window = 1 << 12;
+
+        // 将素数打包为不超过 2^32 的乘积，每组只需对大数做一次折叠
+        struct prime_group
+        {
+            std::uint64_t product;
+            std::size_t begin, end;
+        };
+
+        // 跳过 primes[0] = 2，其余素数按顺序打包
+        static std::vector<prime_group> group_primes(const std::vector<std::uint32_t>& primes)
+        {
+            std::vector<prime_group> result;
+
+            for(std::size_t i = 1; i < primes.size(); )
+            {
+                prime_group group{1, i, i};
+                while(group.end < primes.size() && group.product * primes[group.end] < (std::uint64_t(1) << 32))
+                    group.product *= primes[group.end++];
+
+                result.push_back(group);
+                i = group.end;
+            }
+
+            return result;
+        }
+
+        static const std::vector<std::uint32_t>& trial_primes()
+        {
+            static const std::vector<std::uint32_t> primes = __prime_sieve(trial_bound);
+            return primes;
+        }
+
+        static const std::vector<prime_group>& trial_groups()
+        {
+            static const std::vector<prime_group> groups = group_primes(trial_primes());
+            return groups;
+        }
+
+        static const std::vector<std::uint32_t>& sieve_primes()
+        {
+            static const std::vector<std::uint32_t> primes = __prime_sieve(sieve_bound);
+            return primes;
+        }
+
+        static const std::vector<prime_group>& sieve_groups()
+        {
+            static const std::vector<prime_group> groups = group_primes(sieve_primes());
+            return groups;
+        }
+
+        static std::uint64_t low_unit(const vinteger& x) {
+            return x.empty() ? 0 : x.__buffer[0];
+        }
+
+        // |x| mod m，从高位到低位逐个计算单元折叠，m 须小于 2^32
+        static std::uint64_t unit_residue(const vinteger& x, const std::uint64_t m)
+        {
+            const std::uint64_t base = (std::uint64_t(-1) % m + 1) % m;
+
+            std::uint64_t r = 0;
+            for(std::size_t i = x.__value_length(); i-- > 0; )
+                r = (r * base + x.__buffer[i] % m) % m;
+
+            return r;
+        }
+
+        // x 的二进制末尾 0 的个数，x 须非 0
+        static std::size_t trailing_zeros(const vinteger& x)
+        {
+            std::size_t i = 0;
+            while(x.__buffer[i] == 0)
+                ++i;
+
+            return i * __CUtype_bit_length + std::countr_zero(x.__buffer[i]);
+        }
+
+        // 机器整数上的 Jacobi 符号，n 为正奇数，a < n
+        static int unit_jacobi(std::uint64_t a, std::uint64_t n)
+        {
+            int result = 1;
+            while(a != 0)
+            {
+                const int t = std::countr_zero(a);
+                a >>= t;
+                if((t & 1) && (n % 8 == 3 || n % 8 == 5))
+                    result = -result;
+
+                std::swap(a, n);
+                if(a % 4 == 3 && n % 4 == 3)
+                    result = -result;
+
+                a %= n;
+            }
+
+            return n == 1 ? result : 0;
+        }
+
+        // 按试除素数筛查，n 须为正
+        // 返回 1 表示 n 为小素数，0 表示 n 含小素因子，-1 表示尚未确定
+        static int trial_division(const vinteger& n)
+        {
+            if(n.value_bit_width() <= __CUtype_bit_length && low_unit(n) < 2)
+                return 0;
+
+            if(low_unit(n) % 2 == 0)
+                return n.value_bit_width() == 2 ? 1 : 0;
+
+            const std::vector<std::uint32_t>& primes = trial_primes();
+            for(const prime_group& group : trial_groups())
+            {
+                const std::uint64_t r = unit_residue(n, group.product);
+                for(std::size_t i = group.begin; i < group.end; ++i)
+                    if(r % primes[i] == 0)
+                        return n.value_bit_width() <= __CUtype_bit_length && low_unit(n) == primes[i] ? 1 : 0;
+            }
+
+            // 没有不超过 trial_bound 的素因子，且 n < trial_bound^2
+            if(n.value_bit_width() <= __CUtype_bit_length && low_unit(n) < std::uint64_t(trial_bound) * trial_bound)
+                return 1;
+
+            return -1;
+        }
+
+
+
+        // 以 base 为底的强概率素数测试（Miller-Rabin），n 须为大于 3 的奇数
+        static bool miller_rabin(const mod_context& context, const vinteger& base)
+        {
+            const vinteger& n = context.modulus();
+            const vinteger n_minus_one = n - 1;
+            const std::size_t s = trailing_zeros(n_minus_one);
+
+            const vinteger one = context.one(), minus_one = context.to_domain(n_minus_one);
+            vinteger x = context.pow(context.to_domain(base), n_minus_one >> s);
+
+            if(std::is_eq(x <=> one) || std::is_eq(x <=> minus_one))
+                return true;
+
+            for(std::size_t i = 1; i < s; ++i)
+            {
+                x = context.sqr(x);
+                if(std::is_eq(x <=> minus_one))
+                    return true;
+
+                if(std::is_eq(x <=> one))
+                    return false;
+            }
+
+            return false;
+        }
+
+        // 约简域中的 x / 2，约简域是线性的，直接对代表元减半即可
+        static vinteger half(const mod_context& context, const vinteger& x) {
+            return (low_unit(x) & 1 ? x + context.modulus() : x) >> 1;
+        }
+
+        // 强 Lucas 概率素数测试，参数按 Selfridge 方法 A 选取：P = 1，Q = (1 - D) / 4
+        // n 须为大于 3 的奇数且不是完全平方数
+        static bool strong_lucas(const mod_context& context)
+        {
+            const vinteger& n = context.modulus();
+
+            // D 依次取 5, -7, 9, -11, ...，直到 (D / n) = -1
+            std::int64_t d = 5;
+            for(;; d = d > 0 ? -(d + 2) : -d + 2)
+            {
+                const int j = jacobi(d, n);
+                if(j == -1)
+                    break;
+
+                if(j == 0 && n > (d < 0 ? -d : d))
+                    return false;
+            }
+
+            const vinteger dd = context.to_domain(d), q = context.to_domain((1 - d) / 4);
+            const vinteger n_plus_one = n + 1;
+            const std::size_t s = trailing_zeros(n_plus_one);
+            const vinteger k = n_plus_one >> s;
+
+            // 从 k 的最高位开始倍增：U_1 = 1，V_1 = P = 1
+            vinteger u = context.one(), v = context.one(), qk = q;
+            for(std::size_t i = k.value_bit_width() - 1; i-- > 0; )
+            {
+                // U_2m = U_m * V_m，V_2m = V_m^2 - 2 * Q^m
+                u = context.mul(u, v);
+                v = context.sub(context.sqr(v), context.add(qk, qk));
+                qk = context.sqr(qk);
+
+                if(k.__buffer[i / __CUtype_bit_length] >> (i % __CUtype_bit_length) & 1)
+                {
+                    // U_2m+1 = (P * U_2m + V_2m) / 2，V_2m+1 = (D * U_2m + P * V_2m) / 2
+                    vinteger next_u = half(context, context.add(u, v));
+                    v = half(context, context.add(context.mul(dd, u), v));
+                    u = std::move(next_u);
+                    qk = context.mul(qk, q);
+                }
+            }
+
+            if(u.empty() || v.empty())
+                return true;
+
+            for(std::size_t r = 1; r < s; ++r)
+            {
+                v = context.sub(context.sqr(v), context.add(qk, qk));
+                if(v.empty())
+                    return true;
+
+                qk = context.sqr(qk);
+            }
+
+            return false;
+        }
+
+        // 已通过试除的奇数 n 上的 Baillie-PSW 测试，另加 extra_rounds 轮随机底数的 Miller-Rabin
+        static bool probable_prime(const vinteger& n, const int extra_rounds)
+        {
+            const mod_context context(n);
+
+            if(!miller_rabin(context, 2))
+                return false;
+
+            if(is_perfect_square(n) || !strong_lucas(context))
+                return false;
+
+            // 底数由 n 确定地生成，使同一输入的结果可以复现
+            std::mt19937_64 generator(low_unit(n));
+            const bool single = n.value_bit_width() <= __CUtype_bit_length;
+
+            for(int i = 0; i < extra_rounds; ++i)
+            {
+                std::uint64_t base = single ? 3 + generator() % (low_unit(n) - 4) : generator();
+                if(base < 3)
+                    base += 3;
+
+                if(!miller_rabin(context, base))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+
+
+    int jacobi(const vinteger& a, const vinteger& n)
+    {
+        if(n.sign() <= 0 || prime_context::low_unit(n) % 2 == 0)
+            throw std::invalid_argument("jacobi symbol requires a positive odd modulus");
+
+        int result = 1;
+
+        // (-1 / n) = (-1)^((n - 1) / 2)
+        vinteger x = a.sign() < 0 ? -a : a, y = n;
+        if(a.sign() < 0 && prime_context::low_unit(n) % 4 == 3)
+            result = -result;
+
+        if(x >= y)
+            x = x % y;
+
+        while(y.value_bit_width() > prime_context::__CUtype_bit_length)
+        {
+            if(x.empty())
+                return 0;
+
+            const std::size_t t = prime_context::trailing_zeros(x);
+            x >>= t;
+            if((t & 1) && (prime_context::low_unit(y) % 8 == 3 || prime_context::low_unit(y) % 8 == 5))
+                result = -result;
+
+            // 二次互反律
+            if(prime_context::low_unit(x) % 4 == 3 && prime_context::low_unit(y) % 4 == 3)
+                result = -result;
+
+            // x 足够小时，y mod x 只需一次折叠
+            vinteger r = x.value_bit_width() <= 32 ? vinteger(prime_context::unit_residue(y, prime_context::low_unit(x))) : y % x;
+            y = std::move(x), x = std::move(r);
+        }
+
+        return result * prime_context::unit_jacobi(prime_context::low_unit(x), prime_context::low_unit(y));
+    }
+
+
+
+    bool vinteger::is_probable_prime(int rounds) const
+    {
+        const vinteger n = sign() < 0 ? -*this : *this;
+
+        if(const int r = prime_context::trial_division(n); r >= 0)
+            return r == 1;
+
+        // 与 GMP 一致：Baillie-PSW 之外，rounds 超过 24 的部分再做随机底数的 Miller-Rabin
+        return prime_context::probable_prime(n, rounds > 24 ? rounds - 24 : 0);
+    }
+
+    vinteger vinteger::next_prime() const
+    {
+        if(*this < 2)
+            return 2;
+
+        vinteger candidate = *this + 1;
+        if(prime_context::low_unit(candidate) % 2 == 0)
+            candidate += 1;
+
+        // 候选值不超过筛素数上界时，直接逐个测试
+        while(candidate <= prime_context::sieve_bound)
+        {
+            if(candidate.is_probable_prime())
+                return candidate;
+
+            candidate += 2;
+        }
+
+        // 分段筛：窗口内的候选值为 candidate + 2i，对每个小素数 p 一次性求出首个整除位置并标记其倍数
+        // 小素数按乘积打包，每个窗口对候选值的折叠次数等于组数而不是素数个数，组内的余数只需机器整数取模
+        const std::vector<std::uint32_t>& primes = prime_context::sieve_primes();
+        std::vector<bool> composite(prime_context::sieve_window);
+
+        for(;;)
+        {
+            std::fill(composite.begin(), composite.end(), false);
+
+            for(const prime_context::prime_group& group : prime_context::sieve_groups())
+            {
+                const std::uint64_t residue = prime_context::unit_residue(candidate, group.product);
+
+                for(std::size_t j = group.begin; j < group.end; ++j)
+                {
+                    const std::uint64_t p = primes[j], r = residue % p;
+
+                    // candidate + 2i ≡ 0 (mod p)，即 i ≡ -r * 2^-1 (mod p)
+                    for(std::uint64_t i = (p - r) % p * ((p + 1) / 2) % p; i < prime_context::sieve_window; i += p)
+                        composite[i] = true;
+                }
+            }
+
+            for(std::size_t i = 0; i < prime_context::sieve_window; ++i)
+            {
+                if(composite[i])
+                    continue;
+
+                // 与 is_probable_prime() 的默认轮数一致
+                vinteger n = candidate + 2 * i;
+                if(prime_context::probable_prime(n, 1))
+                    return n;
+            }
+
+            candidate += 2 * prime_context::sieve_window;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "vinteger_kernel.h"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace algae
+{
+    struct reduction_context
+    {
+        // 将 [0, count) 切分为 task_count 段，并行执行 function(begin, end, index)
+        static void for_chunks(const std::size_t count, const std::size_t task_count, const std::function<void(std::size_t, std::size_t, std::size_t)>& function)
+        {
+            std::vector<std::function<void()>> tasks;
+            for(std::size_t k = 0; k < task_count; ++k)
+                tasks.emplace_back([&, k] { function(count * k / task_count, count * (k + 1) / task_count, k); });
+
+            __parallel_invoke(tasks);
+        }
+
+        // 按总规模与粒度决定任务数
+        static std::size_t task_count(const std::size_t threads, const std::size_t count, const std::size_t total_units, const std::size_t grain) {
+            return std::max<std::size_t>(1, std::min({threads, count, total_units / std::max<std::size_t>(grain, 1)}));
+        }
+
+        static std::size_t total_units(const vinteger* const* items, const std::size_t count)
+        {
+            std::size_t total = 0;
+            for(std::size_t i = 0; i < count; ++i)
+                total += items[i]->__value_length();
+
+            return total;
+        }
+
+        // 平衡乘积树，上层的两棵子树作为并行任务，线程预算对半分
+        static vinteger product_tree(const vinteger* const* items, const std::size_t count, const std::size_t threads, const std::size_t grain)
+        {
+            if(count == 0)
+                return 1;
+
+            if(count == 1)
+                return *items[0];
+
+            const std::size_t half = count / 2;
+            vinteger left, right;
+
+            if(threads > 1 && total_units(items, count) >= grain)
+            {
+                std::vector<std::function<void()>> tasks;
+                tasks.emplace_back([&] { left = product_tree(items, half, threads - threads / 2, grain); });
+                tasks.emplace_back([&] { right = product_tree(items + half, count - half, threads / 2, grain); });
+                __parallel_invoke(tasks);
+            }
+            else
+            {
+                left = product_tree(items, half, 1, grain);
+                right = product_tree(items + half, count - half, 1, grain);
+            }
+
+            return mul(left, right, exec_policy{threads, grain});
+        }
+    };
+
+
+
+    vinteger __sum(const vinteger* const* items, const std::size_t count, const exec_policy& policy)
+    {
+        const std::size_t tasks = reduction_context::task_count(__policy_threads(policy), count, reduction_context::total_units(items, count), policy.grain);
+        std::vector<vinteger_accumulator> partial(tasks);
+
+        reduction_context::for_chunks(count, tasks, [&](std::size_t begin, std::size_t end, std::size_t k)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+                partial[k].add(*items[i]);
+        });
+
+        for(std::size_t k = 1; k < tasks; ++k)
+            partial[0].merge(partial[k]);
+
+        return partial[0].value();
+    }
+
+    vinteger __product(const vinteger* const* items, const std::size_t count, const exec_policy& policy)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            if(items[i]->empty())
+                return 0;
+
+        return reduction_context::product_tree(items, count, __policy_threads(policy), policy.grain);
+    }
+
+    vinteger __dot(const vinteger* const* a, const std::size_t a_count, const vinteger* const* b, const std::size_t b_count, const exec_policy& policy)
+    {
+        if(a_count != b_count)
+            throw std::invalid_argument("dot product of ranges with different lengths");
+
+        const std::size_t count = a_count;
+        const std::size_t units = reduction_context::total_units(a, count) + reduction_context::total_units(b, count);
+        const std::size_t tasks = reduction_context::task_count(__policy_threads(policy), count, units, policy.grain);
+        std::vector<vinteger_accumulator> partial(tasks);
+
+        // 各段内的乘积直接逐列累加，不保留中间乘积
+        reduction_context::for_chunks(count, tasks, [&](std::size_t begin, std::size_t end, std::size_t k)
+        {
+            for(std::size_t i = begin; i < end; ++i)
+                partial[k].addmul(*a[i], *b[i]);
+        });
+
+        for(std::size_t k = 1; k < tasks; ++k)
+            partial[0].merge(partial[k]);
+
+        return partial[0].value();
+    }
+}
@@ -0,0 +1,172 @@
+#include "vinteger.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace algae
+{
+    // 模 M 的二次剩余表
+    template<std::size_t M>
+    constexpr static std::array<bool, M> __quadratic_residues()
+    {
+        std::array<bool, M> table{};
+        for(std::size_t i = 0; i < M; ++i)
+            table[i * i % M] = true;
+
+        return table;
+    }
+
+    struct root_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        // 二次剩余过滤使用的模数：64 直接取最低计算单元，63 * 65 * 11 = 45045 由一次折叠求出
+        constexpr static std::uint32_t residue_modulus = 63 * 65 * 11;
+
+        constexpr static std::array<bool, 64> residues_64 = __quadratic_residues<64>();
+        constexpr static std::array<bool, 63> residues_63 = __quadratic_residues<63>();
+        constexpr static std::array<bool, 65> residues_65 = __quadratic_residues<65>();
+        constexpr static std::array<bool, 11> residues_11 = __quadratic_residues<11>();
+
+        static std::uint64_t low_unit(const vinteger& x) {
+            return x.empty() ? 0 : x.__buffer[0];
+        }
+
+        // |x| mod m，从高位到低位逐个计算单元折叠，m 须小于 2^32
+        static std::uint64_t unit_residue(const vinteger& x, const std::uint64_t m)
+        {
+            const std::uint64_t base = (std::uint64_t(-1) % m + 1) % m;
+
+            std::uint64_t r = 0;
+            for(std::size_t i = x.__value_length(); i-- > 0; )
+                r = (r * base + x.__buffer[i] % m) % m;
+
+            return r;
+        }
+
+        // 判断 base^k 是否不超过 limit，超出时提前返回
+        static bool power_not_greater(const std::uint64_t base, const std::uint64_t k, const std::uint64_t limit)
+        {
+            std::uint64_t power = 1;
+            for(std::uint64_t i = 0; i < k; ++i)
+            {
+                if(base != 0 && power > limit / base)
+                    return false;
+
+                power *= base;
+            }
+
+            return true;
+        }
+
+        // 单计算单元的 k 次方根：以浮点估计为初值，再逐一修正舍入误差
+        // k >= 2 时根不超过 2^32，估计值先截断到该范围再转换，避免 double(x) 舍入到 2^64 后转换溢出
+        static std::uint64_t unit_root(const std::uint64_t x, const std::uint64_t k)
+        {
+            if(k == 1)
+                return x;
+
+            const double estimate = k == 2 ? std::sqrt(double(x)) : std::pow(double(x), 1.0 / double(k));
+            std::uint64_t r = std::uint64_t(std::min(estimate, 4294967296.0));
+
+            while(r > 0 && !power_not_greater(r, k, x))
+                --r;
+
+            while(power_not_greater(r + 1, k, x))
+                ++r;
+
+            return r;
+        }
+
+        // 精度倍增的牛顿迭代，x 须非负
+        // 先对 x >> (k * j) 递归求根，得到约一半位数的近似值，左移 j 位后作为上界初值
+        // 整数牛顿迭代从上方单调收敛，初值已有一半的正确位数，通常两三次迭代即停止
+        static vinteger root(const vinteger& x, const std::uint64_t k)
+        {
+            // 2^n > x，k >= n 时根只能是 0 或 1
+            const std::size_t n = x.value_bit_width();
+            if(k >= n)
+                return x.empty() ? 0 : 1;
+
+            if(n <= __CUtype_bit_length)
+                return unit_root(low_unit(x), k);
+
+            const std::size_t root_bits = (n + k - 1) / k;
+            if(root_bits < 4)
+                return newton(x, k, vinteger(1) << root_bits);
+
+            const std::size_t j = root_bits / 2;
+            vinteger r = (root(x >> (k * j), k) + 1) << j;
+
+            return newton(x, k, std::move(r));
+        }
+
+        // 从上界 r 出发迭代 r <- ((k - 1) * r + x / r^(k - 1)) / k，直到不再减小
+        static vinteger newton(const vinteger& x, const std::uint64_t k, vinteger r)
+        {
+            for(;;)
+            {
+                vinteger next = k == 2 ? (r + x / r) >> 1 : (r * (k - 1) + x / pow(r, k - 1)) / k;
+                if(next >= r)
+                    return r;
+
+                r = std::move(next);
+            }
+        }
+    };
+
+
+
+    vinteger isqrt(const vinteger& n)
+    {
+        if(n.sign() < 0)
+            throw std::invalid_argument("square root of negative number");
+
+        return root_context::root(n, 2);
+    }
+
+    vinteger sqrtrem(const vinteger& n, vinteger& remainder)
+    {
+        vinteger s = isqrt(n);
+        remainder = n - s * s;
+        return s;
+    }
+
+    vinteger iroot(const vinteger& n, std::uint64_t k)
+    {
+        if(k == 0)
+            throw std::invalid_argument("zeroth root is undefined");
+
+        if(k == 1)
+            return n;
+
+        if(n.sign() < 0)
+        {
+            if(k % 2 == 0)
+                throw std::invalid_argument("even root of negative number");
+
+            return -root_context::root(-n, k);
+        }
+
+        return root_context::root(n, k);
+    }
+
+    bool is_perfect_square(const vinteger& n)
+    {
+        if(n.sign() <= 0)
+            return n.empty();
+
+        // 依次以模 64、63、65、11 的二次剩余过滤，非平方数约 99% 在此被排除
+        if(!root_context::residues_64[root_context::low_unit(n) % 64])
+            return false;
+
+        const std::uint64_t r = root_context::unit_residue(n, root_context::residue_modulus);
+        if(!root_context::residues_63[r % 63] || !root_context::residues_65[r % 65] || !root_context::residues_11[r % 11])
+            return false;
+
+        vinteger remainder;
+        sqrtrem(n, remainder);
+        return remainder.empty();
+    }
+}
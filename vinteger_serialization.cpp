@@ -0,0 +1,240 @@
+#include "vinteger.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace algae
+{
+    struct serialization_context
+    {
+        using __CUtype = vinteger::__CUtype;
+        constexpr static std::size_t __CUtype_bit_length = vinteger::__CUtype_bit_length;
+
+        static_assert(sizeof(__CUtype) == sizeof(std::uint64_t), "limbs are serialized as 64-bit words");
+
+        // 记录格式（版本 1）
+        //   字节 0      版本号
+        //   字节 1      标志：bit 0 为负号，bit 1 为紧凑形式
+        //   紧凑形式    之后是绝对值的 LEB128 变长编码，只用于位宽不超过 64 的值
+        //   完整形式    字节 2..7 保留为 0，字节 8..15 为小端序的 64 位位宽，之后是小端序的计算单元
+        // 完整形式的头部恰为 16 字节，记录起点按 8 字节对齐时计算单元也对齐，可以原地引用
+        constexpr static std::uint8_t version = 1;
+        constexpr static std::uint8_t negative_flag = 1;
+        constexpr static std::uint8_t compact_flag = 2;
+        constexpr static std::size_t header_size = 16;
+
+        constexpr static bool native_little_endian = std::endian::native == std::endian::little;
+
+        static std::size_t varint_size(std::uint64_t x)
+        {
+            std::size_t size = 1;
+            while(x >>= 7)
+                ++size;
+
+            return size;
+        }
+
+        static std::uint64_t load_word(const std::byte* p)
+        {
+            std::uint64_t x = 0;
+            for(std::size_t i = 0; i < 8; ++i)
+                x |= std::uint64_t(p[i]) << (8 * i);
+
+            return x;
+        }
+
+        static void store_word(std::byte* p, const std::uint64_t x)
+        {
+            for(std::size_t i = 0; i < 8; ++i)
+                p[i] = std::byte(x >> (8 * i));
+        }
+
+        static bool use_compact(const vinteger& x, const bool compact) {
+            return compact && x.value_bit_width() <= __CUtype_bit_length;
+        }
+
+        static std::uint64_t low_unit(const vinteger& x) {
+            return x.empty() ? 0 : x.__buffer[0];
+        }
+
+        static std::size_t record_size(const vinteger& x, const bool compact)
+        {
+            if(use_compact(x, compact))
+                return 2 + varint_size(low_unit(x));
+
+            return header_size + x.__value_length() * sizeof(__CUtype);
+        }
+
+        static std::size_t write(const vinteger& x, std::byte* out, const bool compact)
+        {
+            const std::uint8_t flags = (x.sign() < 0 ? negative_flag : 0) | (use_compact(x, compact) ? compact_flag : 0);
+            out[0] = std::byte(version);
+            out[1] = std::byte(flags);
+
+            if(flags & compact_flag)
+            {
+                std::size_t size = 2;
+                std::uint64_t value = low_unit(x);
+                do
+                {
+                    out[size++] = std::byte((value & 0x7f) | (value >= 0x80 ? 0x80 : 0));
+                    value >>= 7;
+                }
+                while(value);
+
+                return size;
+            }
+
+            std::memset(out + 2, 0, 6);
+            store_word(out + 8, x.value_bit_width());
+
+            const std::size_t length = x.__value_length();
+            if constexpr(native_little_endian)
+            {
+                if(length)
+                    std::memcpy(out + header_size, x.__buffer, length * sizeof(__CUtype));
+            }
+            else
+            {
+                for(std::size_t i = 0; i < length; ++i)
+                    store_word(out + header_size + i * sizeof(__CUtype), x.__buffer[i]);
+            }
+
+            return header_size + length * sizeof(__CUtype);
+        }
+
+        static serialized_record read(const std::span<const std::byte> in)
+        {
+            if(in.size() < 2)
+                throw std::invalid_argument("serialized record is truncated");
+
+            if(std::uint8_t(in[0]) != version)
+                throw std::invalid_argument("unsupported serialization version");
+
+            const std::uint8_t flags = std::uint8_t(in[1]);
+            if(flags & ~(negative_flag | compact_flag))
+                throw std::invalid_argument("serialized record has unknown flags");
+
+            serialized_record record;
+            if(flags & compact_flag)
+            {
+                std::size_t size = 2;
+                for(std::size_t shift = 0; ; shift += 7)
+                {
+                    if(size >= in.size())
+                        throw std::invalid_argument("serialized record is truncated");
+
+                    const std::uint64_t byte = std::uint64_t(in[size++]);
+                    if(shift == 63 && byte > 1)
+                        throw std::invalid_argument("serialized varint is too long");
+
+                    record.small |= (byte & 0x7f) << shift;
+                    if(!(byte & 0x80))
+                        break;
+                }
+
+                record.size = size;
+                record.bit_length = std::bit_width(record.small);
+            }
+            else
+            {
+                if(in.size() < header_size)
+                    throw std::invalid_argument("serialized record is truncated");
+
+                record.bit_length = load_word(in.data() + 8);
+
+                // 先按字节数约束位长再向上取整，位长接近 2^64 时取整会回绕为 0
+                if(record.bit_length > std::uint64_t(std::numeric_limits<decltype(vinteger::__bit_length)>::max()))
+                    throw std::invalid_argument("serialized value is too large");
+
+                if(record.bit_length > std::uint64_t(in.size() - header_size) * 8)
+                    throw std::invalid_argument("serialized record is truncated");
+
+                const std::uint64_t length = (record.bit_length + __CUtype_bit_length - 1) / __CUtype_bit_length;
+                if(length > (in.size() - header_size) / sizeof(__CUtype))
+                    throw std::invalid_argument("serialized record is truncated");
+
+                record.size = header_size + length * sizeof(__CUtype);
+                record.limb_bytes = in.subspan(header_size, length * sizeof(__CUtype));
+
+                // 最高计算单元的位宽须与头部一致，保证每个值只有一种编码
+                if(length && std::uint64_t(std::bit_width(load_word(record.limb_bytes.data() + (length - 1) * sizeof(__CUtype)))) != (record.bit_length - 1) % __CUtype_bit_length + 1)
+                    throw std::invalid_argument("serialized bit length does not match limbs");
+
+                if(native_little_endian && reinterpret_cast<std::uintptr_t>(record.limb_bytes.data()) % alignof(std::uint64_t) == 0)
+                    record.limbs = reinterpret_cast<const std::uint64_t*>(record.limb_bytes.data());
+            }
+
+            if(record.bit_length == 0 && (flags & negative_flag))
+                throw std::invalid_argument("serialized zero has a sign");
+
+            record.sign = record.bit_length == 0 ? 0 : (flags & negative_flag ? -1 : 1);
+
+            // 完整格式的非零值必须带有计算单元，否则 materialize 会把它当作紧凑格式的 small
+            if(!(flags & compact_flag) && record.sign != 0 && record.limb_bytes.empty())
+                throw std::invalid_argument("serialized record has no limbs");
+
+            return record;
+        }
+
+        static vinteger materialize(const serialized_record& record)
+        {
+            vinteger result;
+            if(record.sign == 0)
+                return result;
+
+            if(record.limb_bytes.empty())
+            {
+                result = vinteger(record.small);
+                return record.sign < 0 ? -result : result;
+            }
+
+            const std::size_t length = record.limb_bytes.size() / sizeof(__CUtype);
+            result.__change_capacity(length);
+            if constexpr(native_little_endian)
+                std::memcpy(result.__buffer, record.limb_bytes.data(), record.limb_bytes.size());
+            else
+            {
+                for(std::size_t i = 0; i < length; ++i)
+                    result.__buffer[i] = load_word(record.limb_bytes.data() + i * sizeof(__CUtype));
+            }
+
+            result.__refresh_bit_length(length, record.sign);
+            return result;
+        }
+    };
+
+
+
+    std::size_t serialized_size(const vinteger& x, const bool compact) {
+        return serialization_context::record_size(x, compact);
+    }
+
+    std::size_t serialize(const vinteger& x, const std::span<std::byte> out, const bool compact)
+    {
+        if(out.size() < serialized_size(x, compact))
+            throw std::invalid_argument("output buffer is too small");
+
+        return serialization_context::write(x, out.data(), compact);
+    }
+
+    std::vector<std::byte> serialize(const vinteger& x, const bool compact)
+    {
+        std::vector<std::byte> result(serialized_size(x, compact));
+        serialization_context::write(x, result.data(), compact);
+        return result;
+    }
+
+    serialized_record peek_record(const std::span<const std::byte> in) {
+        return serialization_context::read(in);
+    }
+
+    vinteger deserialize(const std::span<const std::byte> in, std::size_t* consumed)
+    {
+        const serialized_record record = serialization_context::read(in);
+        if(consumed)
+            *consumed = record.size;
+
+        return serialization_context::materialize(record);
+    }
+}
@@ -0,0 +1,208 @@
+#include "vinteger_kernel.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace algae
+{
+    // 工作窃取线程池
+    // 每个工作线程拥有一个双端队列：自己从队尾取任务（后进先出，保持局部性），空闲时从其他队列的队首窃取
+    // 等待子任务的线程不会阻塞，而是继续执行队列中的任务，因此递归的 fork-join 不会死锁
+    class work_stealing_pool
+    {
+        struct task_group
+        {
+            std::atomic<std::size_t> remaining = 0;
+            std::exception_ptr exception;
+            std::mutex exception_mutex;
+        };
+
+        struct task
+        {
+            std::function<void()> function;
+            task_group* group = nullptr;
+        };
+
+        struct worker_queue
+        {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        std::vector<std::unique_ptr<worker_queue>> __queues;
+        std::vector<std::thread> __workers;
+
+        std::atomic<std::size_t> __pending = 0;
+        std::atomic<std::size_t> __next_queue = 0;
+        std::mutex __sleep_mutex;
+        std::condition_variable __wake;
+        bool __stop = false;
+
+        // 当前线程对应的队列下标，非工作线程为 -1
+        static thread_local std::ptrdiff_t __worker_index;
+
+        void __push(task t)
+        {
+            const std::size_t index = __worker_index >= 0 ? std::size_t(__worker_index) : __next_queue++ % __queues.size();
+            {
+                std::lock_guard lock(__queues[index]->mutex);
+                __queues[index]->tasks.push_back(std::move(t));
+            }
+
+            {
+                std::lock_guard lock(__sleep_mutex);
+                ++__pending;
+            }
+            __wake.notify_one();
+        }
+
+        bool __try_pop(task& t)
+        {
+            const std::size_t count = __queues.size();
+            const std::size_t self = __worker_index >= 0 ? std::size_t(__worker_index) : 0;
+
+            if(__worker_index >= 0)
+            {
+                std::lock_guard lock(__queues[self]->mutex);
+                if(!__queues[self]->tasks.empty())
+                {
+                    t = std::move(__queues[self]->tasks.back());
+                    __queues[self]->tasks.pop_back();
+                    --__pending;
+                    return true;
+                }
+            }
+
+            for(std::size_t i = 1; i <= count; ++i)
+            {
+                worker_queue& victim = *__queues[(self + i) % count];
+                std::lock_guard lock(victim.mutex);
+                if(!victim.tasks.empty())
+                {
+                    t = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    --__pending;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        static void __execute(task& t)
+        {
+            try
+            {
+                t.function();
+            }
+            catch(...)
+            {
+                std::lock_guard lock(t.group->exception_mutex);
+                if(!t.group->exception)
+                    t.group->exception = std::current_exception();
+            }
+
+            --t.group->remaining;
+        }
+
+        void __worker_loop(const std::size_t index)
+        {
+            __worker_index = std::ptrdiff_t(index);
+
+            for(;;)
+            {
+                task t;
+                if(__try_pop(t))
+                {
+                    __execute(t);
+                    continue;
+                }
+
+                std::unique_lock lock(__sleep_mutex);
+                __wake.wait(lock, [this] { return __stop || __pending > 0; });
+                if(__stop)
+                    return;
+            }
+        }
+
+    public:
+        explicit work_stealing_pool(const std::size_t worker_count)
+        {
+            for(std::size_t i = 0; i < std::max<std::size_t>(worker_count, 1); ++i)
+                __queues.push_back(std::make_unique<worker_queue>());
+
+            for(std::size_t i = 0; i < worker_count; ++i)
+                __workers.emplace_back(&work_stealing_pool::__worker_loop, this, i);
+        }
+
+        ~work_stealing_pool()
+        {
+            {
+                std::lock_guard lock(__sleep_mutex);
+                __stop = true;
+            }
+            __wake.notify_all();
+
+            for(std::thread& worker : __workers)
+                worker.join();
+        }
+
+        // 在当前线程执行第一个任务，其余任务放入线程池，返回前等待全部完成
+        // 任何任务抛出的异常都会在全部任务结束后重新抛出
+        void invoke(std::vector<std::function<void()>>& functions)
+        {
+            if(functions.empty())
+                return;
+
+            task_group group;
+            group.remaining = functions.size();
+
+            for(std::size_t i = 1; i < functions.size(); ++i)
+                __push(task{std::move(functions[i]), &group});
+
+            task first{std::move(functions[0]), &group};
+            __execute(first);
+
+            while(group.remaining > 0)
+            {
+                task t;
+                if(__try_pop(t))
+                    __execute(t);
+                else
+                    std::this_thread::yield();
+            }
+
+            if(group.exception)
+                std::rethrow_exception(group.exception);
+        }
+
+        // 进程内共享的线程池，调用线程也参与计算，因此工作线程比硬件并发数少一个
+        static work_stealing_pool& instance()
+        {
+            static work_stealing_pool pool(std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1);
+            return pool;
+        }
+    };
+
+    thread_local std::ptrdiff_t work_stealing_pool::__worker_index = -1;
+
+
+
+    std::size_t __policy_threads(const exec_policy& policy) {
+        return policy.threads ? policy.threads : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    void __parallel_invoke(std::vector<std::function<void()>>& functions)
+    {
+        if(functions.size() == 1)
+            return functions[0]();
+
+        work_stealing_pool::instance().invoke(functions);
+    }
+}
@@ -0,0 +1,228 @@
+// 算法阈值调优
+//   vinteger_tune [--output FILE] [--header FILE] [--min-time MS]
+//       在本机上测量各算法的交叉点，写出 read_thresholds 能读取的配置文件（默认输出到标准输出）
+//       以及可通过 CMake 变量 VINTEGER_THRESHOLDS_HEADER 编译进库的头文件
+#include "vinteger.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace algae;
+    using tune_clock = std::chrono::steady_clock;
+
+    // 每次计时至少持续的时间
+    double min_time_ms = 20;
+
+    vinteger random_value(std::mt19937_64& rng, const std::size_t limbs)
+    {
+        std::vector<std::uint64_t> words(limbs);
+        for(std::uint64_t& w : words)
+            w = rng();
+
+        words.back() |= std::uint64_t(1) << 63;
+        return import_bits(words.data(), words.size(), sizeof(std::uint64_t));
+    }
+
+    // 在给定阈值下运算一次的耗时（纳秒），取三次计时的最小值以减少干扰
+    double time_with(const vinteger_thresholds& t, const std::function<std::size_t()>& op)
+    {
+        set_thresholds(t);
+
+        double best = 0;
+        std::size_t sink = 0;
+        for(int round = 0; round < 3; ++round)
+        {
+            std::size_t iterations = 0;
+            const auto start = tune_clock::now();
+            double elapsed = 0;
+            do
+            {
+                sink += op();
+                ++iterations;
+                elapsed = std::chrono::duration<double, std::nano>(tune_clock::now() - start).count();
+            }
+            while(elapsed < min_time_ms * 1e6);
+
+            const double per_op = elapsed / iterations;
+            best = round == 0 ? per_op : std::min(best, per_op);
+        }
+
+        // sink 参与比较，避免运算被优化掉
+        return best + (sink == std::size_t(-1));
+    }
+
+    // 在 [low, high] 中二分查找 faster(n) 成立的最小 n，假定 faster 随 n 单调；都不成立时返回 std::nullopt
+    std::optional<std::size_t> crossover(std::size_t low, const std::size_t high, const std::function<bool(std::size_t)>& faster)
+    {
+        std::size_t end = high + 1;
+        while(low < end)
+        {
+            const std::size_t middle = low + (end - low) / 2;
+            if(faster(middle))
+                end = middle;
+            else
+                low = middle + 1;
+        }
+
+        if(low > high)
+            return std::nullopt;
+
+        return low;
+    }
+
+    // 搜索范围内没有交叉点时不能把上界当作测量结果，报告后保留当前值
+    std::size_t measured(const char* name, const std::optional<std::size_t> n, const std::size_t high, const std::size_t current)
+    {
+        if(n)
+            return *n;
+
+        std::cerr << name << ": no crossover up to " << high << " limbs, keeping " << current << std::endl;
+        return current;
+    }
+
+    // Karatsuba：n 个计算单元的乘法，阈值取 n 时顶层拆分一次（子问题用基本乘法），取 n + 1 时完全使用基本乘法
+    std::size_t tune_karatsuba(vinteger_thresholds t, std::mt19937_64& rng)
+    {
+        constexpr std::size_t high = 256;
+        return measured("karatsuba", crossover(4, high, [&](const std::size_t n) {
+            const vinteger a = random_value(rng, n), b = random_value(rng, n);
+            const auto op = [&] { return (a * b).value_bit_width(); };
+
+            vinteger_thresholds split = t, basecase = t;
+            split.karatsuba = n, basecase.karatsuba = n + 1;
+            const bool faster = time_with(split, op) < time_with(basecase, op);
+            std::cerr << "karatsuba " << n << (faster ? ": split" : ": basecase") << std::endl;
+            return faster;
+        }), high, t.karatsuba);
+    }
+
+    // half-GCD：阈值取 n 时顶层先做一次 half-GCD，取 n + 1 时完全使用 Lehmer 算法
+    // 交叉点通常在数千个计算单元处，上界须留有余量
+    std::size_t tune_half_gcd(vinteger_thresholds t, std::mt19937_64& rng)
+    {
+        constexpr std::size_t high = 16384;
+        return measured("half_gcd", crossover(16, high, [&](const std::size_t n) {
+            const vinteger a = random_value(rng, n), b = random_value(rng, n);
+            const auto op = [&] { return gcd(a, b).value_bit_width(); };
+
+            vinteger_thresholds half = t, lehmer = t;
+            half.half_gcd = n, lehmer.half_gcd = n + 1;
+            const bool faster = time_with(half, op) < time_with(lehmer, op);
+            std::cerr << "half_gcd " << n << (faster ? ": half-gcd" : ": lehmer") << std::endl;
+            return faster;
+        }), high, t.half_gcd);
+    }
+
+    // 累加器：n x n 的 addmul，阈值取 n - 1 时先做快速乘法，取 n 时逐列累加部分积
+    std::size_t tune_accumulator_product(vinteger_thresholds t, std::mt19937_64& rng)
+    {
+        constexpr std::size_t high = 256;
+        const std::optional<std::size_t> n = crossover(4, high, [&](const std::size_t n) {
+            const vinteger a = random_value(rng, n), b = random_value(rng, n);
+            vinteger_accumulator accumulator;
+            const auto op = [&] { accumulator.addmul(a, b); return std::size_t(1); };
+
+            vinteger_thresholds product = t, columns = t;
+            product.accumulator_product = n - 1, columns.accumulator_product = n;
+            const bool faster = time_with(product, op) < time_with(columns, op);
+            std::cerr << "accumulator_product " << n << (faster ? ": product" : ": columns") << std::endl;
+            return faster;
+        });
+
+        return measured("accumulator_product", n ? std::optional<std::size_t>(*n - 1) : std::nullopt, high, t.accumulator_product);
+    }
+
+    // 十进制转换的叶子长度不是单调的交叉点，在候选值中取转换与解析总耗时最小的一个
+    std::size_t tune_radix_leaf(vinteger_thresholds t, std::mt19937_64& rng)
+    {
+        const vinteger x = random_value(rng, 2048);
+        const std::string text = x.to_string();
+        const auto op = [&] { return x.to_string().size() + vinteger(text).value_bit_width(); };
+
+        std::size_t best = t.radix_leaf;
+        double best_time = 0;
+        for(const std::size_t leaf : {4, 8, 12, 16, 24, 32, 48, 64, 96, 128})
+        {
+            t.radix_leaf = leaf;
+            const double time = time_with(t, op);
+            std::cerr << "radix_leaf " << leaf << ": " << time << " ns" << std::endl;
+            if(best_time == 0 || time < best_time)
+                best = leaf, best_time = time;
+        }
+
+        return best;
+    }
+
+    std::string format_header(const vinteger_thresholds& t)
+    {
+        return "// 由 vinteger_tune 生成的算法阈值\n"
+            "#define ALGAE_VINTEGER_KARATSUBA_THRESHOLD " + std::to_string(t.karatsuba) + "\n"
+            "#define ALGAE_VINTEGER_RADIX_LEAF_THRESHOLD " + std::to_string(t.radix_leaf) + "\n"
+            "#define ALGAE_VINTEGER_HALF_GCD_THRESHOLD " + std::to_string(t.half_gcd) + "\n"
+            "#define ALGAE_VINTEGER_ACCUMULATOR_PRODUCT_THRESHOLD " + std::to_string(t.accumulator_product) + "\n";
+    }
+
+    void write_file(const std::string& path, const std::string& content)
+    {
+        std::ofstream out(path);
+        if(!out || !(out << content))
+            throw std::runtime_error("cannot write " + path);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        std::string output, header;
+        for(int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if(i + 1 >= argc)
+                throw std::invalid_argument(arg + " requires a value");
+
+            if(arg == "--output")
+                output = argv[++i];
+            else if(arg == "--header")
+                header = argv[++i];
+            else if(arg == "--min-time")
+                min_time_ms = std::stod(argv[++i]);
+            else
+                throw std::invalid_argument("unknown argument " + arg);
+        }
+
+        std::mt19937_64 rng(20240601);
+        vinteger_thresholds t = thresholds();
+
+        // 依次调优：十进制转换与 half-GCD 依赖乘法，因此先确定 Karatsuba 阈值
+        t.karatsuba = tune_karatsuba(t, rng);
+        t.accumulator_product = tune_accumulator_product(t, rng);
+        t.radix_leaf = tune_radix_leaf(t, rng);
+        t.half_gcd = tune_half_gcd(t, rng);
+        set_thresholds(t);
+
+        const std::string config = "# 由 vinteger_tune 生成，可通过环境变量 ALGAE_VINTEGER_THRESHOLDS 在运行时加载\n" + format_thresholds(thresholds());
+        if(output.empty())
+            std::cout << config;
+        else
+            write_file(output, config);
+
+        if(!header.empty())
+            write_file(header, format_header(thresholds()));
+
+        return 0;
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << "vinteger_tune: " << e.what() << "\n";
+        return 1;
+    }
+}
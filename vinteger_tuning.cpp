@@ -0,0 +1,151 @@
+#include "vinteger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+// vinteger_tune --header 生成的头文件，定义下面的各个宏
+#if defined(ALGAE_VINTEGER_THRESHOLDS_HEADER)
+#include ALGAE_VINTEGER_THRESHOLDS_HEADER
+#endif
+
+#ifndef ALGAE_VINTEGER_KARATSUBA_THRESHOLD
+#define ALGAE_VINTEGER_KARATSUBA_THRESHOLD 32
+#endif
+
+#ifndef ALGAE_VINTEGER_RADIX_LEAF_THRESHOLD
+#define ALGAE_VINTEGER_RADIX_LEAF_THRESHOLD 32
+#endif
+
+#ifndef ALGAE_VINTEGER_HALF_GCD_THRESHOLD
+#define ALGAE_VINTEGER_HALF_GCD_THRESHOLD 1500
+#endif
+
+#ifndef ALGAE_VINTEGER_ACCUMULATOR_PRODUCT_THRESHOLD
+#define ALGAE_VINTEGER_ACCUMULATOR_PRODUCT_THRESHOLD 32
+#endif
+
+namespace algae
+{
+    struct tuning_context
+    {
+        struct entry
+        {
+            const char* name;
+            std::size_t vinteger_thresholds::* field;
+            // 算法正确性要求的下限
+            std::size_t minimum;
+        };
+
+        constexpr static entry entries[] = {
+            {"karatsuba", &vinteger_thresholds::karatsuba, 2},
+            {"radix_leaf", &vinteger_thresholds::radix_leaf, 1},
+            {"half_gcd", &vinteger_thresholds::half_gcd, 2},
+            {"accumulator_product", &vinteger_thresholds::accumulator_product, 0},
+        };
+
+        static vinteger_thresholds compiled()
+        {
+            vinteger_thresholds value;
+            value.karatsuba = ALGAE_VINTEGER_KARATSUBA_THRESHOLD;
+            value.radix_leaf = ALGAE_VINTEGER_RADIX_LEAF_THRESHOLD;
+            value.half_gcd = ALGAE_VINTEGER_HALF_GCD_THRESHOLD;
+            value.accumulator_product = ALGAE_VINTEGER_ACCUMULATOR_PRODUCT_THRESHOLD;
+            return clamp(value);
+        }
+
+        static vinteger_thresholds clamp(vinteger_thresholds value)
+        {
+            for(const entry& e : entries)
+                value.*e.field = std::max(value.*e.field, e.minimum);
+
+            return value;
+        }
+
+        // 配置文件缺失或格式错误时不能让第一次运算抛出异常，在标准错误输出报告一次后使用编译时的默认值
+        static vinteger_thresholds initial()
+        {
+            const char* path = std::getenv("ALGAE_VINTEGER_THRESHOLDS");
+            if(!path || !*path)
+                return compiled();
+
+            try
+            {
+                return read_thresholds(path);
+            }
+            catch(const std::exception& e)
+            {
+                std::cerr << "vinteger: ignoring ALGAE_VINTEGER_THRESHOLDS: " << e.what() << std::endl;
+                return compiled();
+            }
+        }
+
+        // 第一次使用时初始化，之后的读取只是一次引用
+        static vinteger_thresholds& active()
+        {
+            static vinteger_thresholds value = initial();
+            return value;
+        }
+    };
+
+
+
+    const vinteger_thresholds& thresholds() {
+        return tuning_context::active();
+    }
+
+    void set_thresholds(const vinteger_thresholds& value) {
+        tuning_context::active() = tuning_context::clamp(value);
+    }
+
+    vinteger_thresholds read_thresholds(const std::string& path)
+    {
+        std::ifstream in(path);
+        if(!in)
+            throw std::runtime_error("cannot open thresholds file " + path);
+
+        vinteger_thresholds value = tuning_context::compiled();
+        std::string line;
+        for(std::size_t number = 1; std::getline(in, line); ++number)
+        {
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream fields(line);
+            std::string name, equals;
+            std::size_t threshold;
+            if(!(fields >> name))
+                continue;
+
+            if(!(fields >> equals >> std::ws) || equals != "=")
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": expected 'name = value'");
+
+            // 无符号提取会把 "-5" 回绕为极大值，负号须在提取前单独拒绝
+            if(fields.peek() == '-')
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": threshold " + name + " is negative");
+
+            if(!(fields >> threshold) || !(fields >> std::ws).eof())
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": expected 'name = value'");
+
+            bool known = false;
+            for(const tuning_context::entry& e : tuning_context::entries)
+                if(name == e.name)
+                    value.*e.field = threshold, known = true;
+
+            if(!known)
+                throw std::invalid_argument(path + ":" + std::to_string(number) + ": unknown threshold " + name);
+        }
+
+        return tuning_context::clamp(value);
+    }
+
+    std::string format_thresholds(const vinteger_thresholds& value)
+    {
+        std::string result;
+        for(const tuning_context::entry& e : tuning_context::entries)
+            result += std::string(e.name) + " = " + std::to_string(value.*e.field) + "\n";
+
+        return result;
+    }
+}
@@ -0,0 +1,108 @@
+#include "vinteger.h"
+#include <stdexcept>
+
+namespace algae
+{
+    // 借用的 vinteger 容量为 0：它既不会被写入（视图只暴露 const 引用），也不会释放缓冲区
+    void vinteger_view::__borrow(const std::uint64_t* limbs, const std::size_t count, const int sign)
+    {
+        static_assert(std::is_same_v<vinteger::__CUtype, std::uint64_t>, "borrowed limbs must have the computing unit type");
+
+        __value.__buffer = const_cast<vinteger::__CUtype*>(limbs);
+        __value.__capacity = 0;
+        __value.__refresh_bit_length(count, sign < 0 ? -1 : 1);
+
+        if(__value.empty())
+            __value.__buffer = nullptr;
+    }
+
+    vinteger_view::vinteger_view(const std::span<const std::uint64_t> limbs, const int sign) {
+        __borrow(limbs.data(), limbs.size(), sign);
+    }
+
+    vinteger_view::vinteger_view(const vinteger& source) {
+        __borrow(source.__buffer, source.__value_length(), source.sign());
+    }
+
+    vinteger_view::vinteger_view(const serialized_record& record)
+    {
+        if(record.sign == 0)
+            return;
+
+        if(record.limb_bytes.empty())
+        {
+            __small = record.small;
+            __borrow(&__small, 1, record.sign);
+            return;
+        }
+
+        if(record.limbs == nullptr)
+            throw std::invalid_argument("record limbs cannot be referenced in place");
+
+        __borrow(record.limbs, record.limb_bytes.size() / sizeof(std::uint64_t), record.sign);
+    }
+
+    vinteger_view::vinteger_view(const vinteger_view& source) {
+        *this = source;
+    }
+
+    vinteger_view& vinteger_view::operator=(const vinteger_view& source)
+    {
+        if(this == &source)
+            return *this;
+
+        // 源视图借用自身的紧凑计算单元时，副本改为借用自己的那一份
+        __small = source.__small;
+        const std::uint64_t* limbs = source.__value.__buffer == &source.__small ? &__small : source.__value.__buffer;
+
+        __release();
+        __borrow(limbs, source.__value.__value_length(), source.sign());
+        return *this;
+    }
+
+
+
+    int vinteger_view::sign() const {
+        return __value.sign();
+    }
+
+    bool vinteger_view::empty() const {
+        return __value.empty();
+    }
+
+    std::size_t vinteger_view::value_bit_width() const {
+        return __value.value_bit_width();
+    }
+
+    std::span<const std::uint64_t> vinteger_view::limbs() const {
+        return {__value.__buffer, __value.__value_length()};
+    }
+
+    const vinteger& vinteger_view::value() const {
+        return __value;
+    }
+
+    vinteger_view::operator const vinteger&() const {
+        return __value;
+    }
+
+    vinteger vinteger_view::operator-() const {
+        return -__value;
+    }
+
+    vinteger vinteger_view::operator<<(const std::size_t shift) const {
+        return __value << shift;
+    }
+
+    vinteger vinteger_view::operator>>(const std::size_t shift) const {
+        return __value >> shift;
+    }
+
+    std::string vinteger_view::to_string() const {
+        return __value.to_string();
+    }
+
+    std::string vinteger_view::to_string(const exec_policy& policy) const {
+        return __value.to_string(policy);
+    }
+}